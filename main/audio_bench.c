@@ -0,0 +1,67 @@
+#include "audio_bench.h"
+
+#include "hardware/sync.h"
+
+#include "audio_capture.h"
+#include "audio_codec.h"
+#include "audio_decim.h"
+#include "cycle_count.h"
+
+#define N AUDIO_BLOCK_SAMPLES
+
+static int16_t pcm[N];
+static int16_t pcm_out[N];
+static uint8_t bytes[N];
+static uint16_t adc[N];
+static uint16_t decim_out[N];
+
+static uint32_t per_sample(uint32_t start, uint32_t end) {
+    return cycle_count_elapsed(start, end) / N;
+}
+
+void audio_bench_codec(audio_bench_codec_t *r) {
+    // Onda triangular de ±16000: exercita todos os passos do ADPCM
+    for (int i = 0; i < N; i++) {
+        int32_t p = (i * 500) % 64000;
+        pcm[i] = p < 32000 ? p - 16000 : 48000 - p;
+    }
+    cycle_count_start();
+
+    uint32_t irq = save_and_disable_interrupts();
+    adpcm_state_t st = {0, 0};
+    uint32_t t0 = cycle_count_now();
+    adpcm_encode(&st, pcm, N, bytes);
+    uint32_t t1 = cycle_count_now();
+    st.predictor = 0;
+    st.index = 0;
+    uint32_t t2 = cycle_count_now();
+    adpcm_decode(&st, bytes, N, pcm_out);
+    uint32_t t3 = cycle_count_now();
+    for (int i = 0; i < N; i++) bytes[i] = ulaw_encode(pcm[i]);
+    uint32_t t4 = cycle_count_now();
+    for (int i = 0; i < N; i++) pcm_out[i] = ulaw_decode(bytes[i]);
+    uint32_t t5 = cycle_count_now();
+    restore_interrupts(irq);
+
+    r->adpcm_encode = per_sample(t0, t1);
+    r->adpcm_decode = per_sample(t2, t3);
+    r->ulaw_encode = per_sample(t3, t4);
+    r->ulaw_decode = per_sample(t4, t5);
+}
+
+uint32_t audio_bench_decim(void) {
+    // Bloco bruto como o do DMA, com ruído nos bits baixos
+    for (int i = 0; i < N; i++) adc[i] = 2048 + ((i * 1103515245u) >> 20) % 512 - 256;
+    audio_decim_t d;
+    audio_decim_reset(&d);
+    cycle_count_start();
+
+    // DECIM_R blocos brutos rendem N saídas, como na IRQ da captura
+    uint32_t irq = save_and_disable_interrupts();
+    uint32_t t0 = cycle_count_now();
+    for (int b = 0; b < DECIM_R; b++) audio_decim_process(&d, adc, N, &decim_out[b * (N / DECIM_R)]);
+    uint32_t t1 = cycle_count_now();
+    restore_interrupts(irq);
+
+    return per_sample(t0, t1);
+}
@@ -0,0 +1,20 @@
+#ifndef AUDIO_BENCH_H
+#define AUDIO_BENCH_H
+
+#include <stdint.h>
+
+// Ciclos de CPU por amostra dos codecs num bloco de AUDIO_BLOCK_SAMPLES,
+// medidos com o SysTick como em servo_pulse_bench
+typedef struct {
+    uint32_t adpcm_encode;
+    uint32_t adpcm_decode;
+    uint32_t ulaw_encode;
+    uint32_t ulaw_decode;
+} audio_bench_codec_t;
+
+// Reconfigura o SysTick e roda com as IRQs desligadas: chamar no boot
+void audio_bench_codec(audio_bench_codec_t *r);
+// Ciclos por amostra de saída do CIC + FIR em AUDIO_BLOCK_SAMPLES saídas
+uint32_t audio_bench_decim(void);
+
+#endif
@@ -0,0 +1,161 @@
+#include "audio_capture.h"
+
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+
+#include "audio_decim.h"
+
+#define ADC_CLOCK_HZ 48000000
+
+// Ping-pong: enquanto o DMA enche um bloco, o outro vai para o stream
+static uint16_t blocks[2][AUDIO_BLOCK_SAMPLES];
+
+// Sobreamostragem: cada bloco bruto rende AUDIO_BLOCK_SAMPLES / DECIM_R
+// amostras, acumuladas aqui até completar um bloco
+static bool oversampling = false;
+static audio_decim_t decim;
+static uint16_t decim_out[AUDIO_BLOCK_SAMPLES];
+static uint32_t decim_fill = 0;
+static uint base_rate;
+
+_Static_assert(AUDIO_BLOCK_SAMPLES % DECIM_R == 0, "bloco bruto deve render saídas inteiras");
+
+static int dma_ch[2] = {-1, -1};
+static volatile bool capturing = false;
+static bool streaming = false;
+static audio_capture_done_cb_t done_cb = NULL;
+static StreamBufferHandle_t stream = NULL;
+static volatile uint32_t dropped = 0;
+
+static void send_block(const uint16_t *blk, BaseType_t *woken) {
+    // Só blocos inteiros entram no stream, para o consumidor não
+    // perder o alinhamento
+    if (xStreamBufferSpacesAvailable(stream) >= AUDIO_BLOCK_BYTES) {
+        xStreamBufferSendFromISR(stream, blk, AUDIO_BLOCK_BYTES, woken);
+    } else {
+        dropped += AUDIO_BLOCK_SAMPLES;
+    }
+}
+
+static void set_rate(uint rate) {
+    // Período de conversão = (1 + div) ciclos do clock de 48 MHz
+    adc_set_clkdiv((float)ADC_CLOCK_HZ / rate - 1.0f);
+}
+
+static void capture_dma_handler(void) {
+    BaseType_t woken = pdFALSE;
+
+    // IRQ compartilhada: só trata os canais da captura
+    for (int i = 0; i < 2; i++) {
+        if (!dma_channel_get_irq0_status(dma_ch[i])) continue;
+        dma_channel_acknowledge_irq0(dma_ch[i]);
+
+        if (!streaming) {
+            adc_run(false);
+            adc_fifo_drain();
+            capturing = false;
+            if (done_cb) done_cb();
+            continue;
+        }
+
+        // O outro canal já foi disparado pelo chain; rearma este sem disparar.
+        // O bloco precisa ser consumido antes do outro encher.
+        dma_channel_set_write_addr(dma_ch[i], blocks[i], false);
+
+        if (!oversampling) {
+            send_block(blocks[i], &woken);
+            continue;
+        }
+
+        audio_decim_process(&decim, blocks[i], AUDIO_BLOCK_SAMPLES, &decim_out[decim_fill]);
+        decim_fill += AUDIO_BLOCK_SAMPLES / DECIM_R;
+        if (decim_fill == AUDIO_BLOCK_SAMPLES) {
+            decim_fill = 0;
+            send_block(decim_out, &woken);
+        }
+    }
+
+    portYIELD_FROM_ISR(woken);
+}
+
+static void configure_channel(int i, bool chain) {
+    dma_channel_config cfg = dma_channel_get_default_config(dma_ch[i]);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
+    channel_config_set_read_increment(&cfg, false);
+    channel_config_set_write_increment(&cfg, true);
+    channel_config_set_dreq(&cfg, DREQ_ADC);
+    // Encadear em si mesmo desliga o chain
+    channel_config_set_chain_to(&cfg, chain ? dma_ch[i ^ 1] : dma_ch[i]);
+    dma_channel_configure(dma_ch[i], &cfg, blocks[i], &adc_hw->fifo,
+                          AUDIO_BLOCK_SAMPLES, false);
+}
+
+void audio_capture_init(uint adc_input, uint sample_rate) {
+    adc_select_input(adc_input);
+    adc_fifo_setup(true,    // cada conversão vai para o FIFO
+                   true,    // DREQ para o DMA
+                   1,       // DREQ a cada amostra
+                   false,   // sem bit de erro
+                   false);  // mantém os 12 bits
+    base_rate = sample_rate;
+    set_rate(sample_rate);
+
+    for (int i = 0; i < 2; i++) {
+        dma_ch[i] = dma_claim_unused_channel(true);
+        dma_channel_set_irq0_enabled(dma_ch[i], true);
+    }
+    irq_add_shared_handler(DMA_IRQ_0, capture_dma_handler,
+                           PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+}
+
+void audio_capture_start(uint16_t *buf, uint32_t n_samples, audio_capture_done_cb_t cb) {
+    done_cb = cb;
+    streaming = false;
+    capturing = true;
+    set_rate(base_rate);
+    configure_channel(0, false);
+    adc_fifo_drain();
+    dma_channel_transfer_to_buffer_now(dma_ch[0], buf, n_samples);
+    adc_run(true);
+}
+
+void audio_capture_stream_start(StreamBufferHandle_t sb) {
+    stream = sb;
+    streaming = true;
+    capturing = true;
+    set_rate(oversampling ? base_rate * DECIM_R : base_rate);
+    audio_decim_reset(&decim);
+    decim_fill = 0;
+    configure_channel(0, true);
+    configure_channel(1, true);
+    adc_fifo_drain();
+    dma_channel_start(dma_ch[0]);
+    adc_run(true);
+}
+
+void audio_capture_stop(void) {
+    adc_run(false);
+    // Abortar pode gerar IRQ espúria (errata RP2040-E13)
+    for (int i = 0; i < 2; i++) {
+        dma_channel_set_irq0_enabled(dma_ch[i], false);
+        dma_channel_abort(dma_ch[i]);
+        dma_channel_acknowledge_irq0(dma_ch[i]);
+        dma_channel_set_irq0_enabled(dma_ch[i], true);
+    }
+    adc_fifo_drain();
+    capturing = false;
+}
+
+void audio_capture_set_oversampling(bool on) {
+    oversampling = on;
+}
+
+bool audio_capture_busy(void) {
+    return capturing;
+}
+
+uint32_t audio_capture_dropped(void) {
+    return dropped;
+}
@@ -0,0 +1,38 @@
+#ifndef AUDIO_CAPTURE_H
+#define AUDIO_CAPTURE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+
+#include "FreeRTOS.h"
+#include "stream_buffer.h"
+
+// Tamanho de cada metade do ping-pong (32 ms a 8 kHz)
+#define AUDIO_BLOCK_SAMPLES 256
+#define AUDIO_BLOCK_BYTES (AUDIO_BLOCK_SAMPLES * sizeof(uint16_t))
+
+// Chamado da IRQ do DMA quando a captura termina
+typedef void (*audio_capture_done_cb_t)(void);
+
+// ADC em modo free-running: o divisor de clock fixa a taxa e o DMA
+// copia cada conversão (12 bits em uint16_t) do FIFO para o buffer,
+// sem uso de CPU.
+void audio_capture_init(uint adc_input, uint sample_rate);
+void audio_capture_start(uint16_t *buf, uint32_t n_samples, audio_capture_done_cb_t cb);
+
+// Captura contínua em blocos de AUDIO_BLOCK_SAMPLES enviados ao stream
+// buffer pela IRQ; roda até audio_capture_stop().
+void audio_capture_stream_start(StreamBufferHandle_t sb);
+
+// Stream a DECIM_R x sample_rate, decimado por CIC + FIR na IRQ: menos
+// ruído e anti-aliasing antes de voltar a sample_rate. Vale a partir do
+// próximo audio_capture_stream_start().
+void audio_capture_set_oversampling(bool on);
+
+void audio_capture_stop(void);
+bool audio_capture_busy(void);
+// Amostras descartadas por stream buffer cheio
+uint32_t audio_capture_dropped(void);
+
+#endif
@@ -0,0 +1,122 @@
+#include "audio_codec.h"
+
+#include "pico/platform.h"
+
+static const int8_t adpcm_index_table[16] = {
+    -1, -1, -1, -1, 2, 4, 6, 8,
+    -1, -1, -1, -1, 2, 4, 6, 8,
+};
+
+static const int16_t adpcm_step_table[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17,
+    19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118,
+    130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+    337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+    876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+    2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358,
+    5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767,
+};
+
+// Reconstrução comum ao codificador e ao decodificador, para os dois
+// seguirem exatamente o mesmo preditor
+static inline int16_t adpcm_update(adpcm_state_t *st, uint8_t code) {
+    int32_t step = adpcm_step_table[st->index];
+    int32_t delta = step >> 3;
+    if (code & 4) delta += step;
+    if (code & 2) delta += step >> 1;
+    if (code & 1) delta += step >> 2;
+
+    int32_t pred = st->predictor + ((code & 8) ? -delta : delta);
+    if (pred > 32767) pred = 32767;
+    else if (pred < -32768) pred = -32768;
+    st->predictor = pred;
+
+    int32_t index = st->index + adpcm_index_table[code];
+    if (index < 0) index = 0;
+    else if (index > 88) index = 88;
+    st->index = index;
+
+    return pred;
+}
+
+static inline uint8_t adpcm_encode_sample(adpcm_state_t *st, int16_t s) {
+    int32_t step = adpcm_step_table[st->index];
+    int32_t diff = s - st->predictor;
+    uint8_t code = 0;
+
+    if (diff < 0) {
+        code = 8;
+        diff = -diff;
+    }
+    if (diff >= step) {
+        code |= 4;
+        diff -= step;
+    }
+    step >>= 1;
+    if (diff >= step) {
+        code |= 2;
+        diff -= step;
+    }
+    step >>= 1;
+    if (diff >= step) code |= 1;
+
+    adpcm_update(st, code);
+    return code;
+}
+
+void __not_in_flash_func(adpcm_encode)(adpcm_state_t *st, const int16_t *in, uint32_t n, uint8_t *out) {
+    uint32_t i = 0;
+    for (; i + 1 < n; i += 2) {
+        uint8_t lo = adpcm_encode_sample(st, in[i]);
+        uint8_t hi = adpcm_encode_sample(st, in[i + 1]);
+        *out++ = lo | (hi << 4);
+    }
+    if (i < n) *out = adpcm_encode_sample(st, in[i]);
+}
+
+void __not_in_flash_func(adpcm_decode)(adpcm_state_t *st, const uint8_t *in, uint32_t n, int16_t *out) {
+    uint32_t i = 0;
+    for (; i + 1 < n; i += 2) {
+        uint8_t b = *in++;
+        out[i] = adpcm_update(st, b & 0x0f);
+        out[i + 1] = adpcm_update(st, b >> 4);
+    }
+    if (i < n) out[i] = adpcm_update(st, *in & 0x0f);
+}
+
+int16_t adpcm_decode_nibble(adpcm_state_t *st, uint8_t code) {
+    return adpcm_update(st, code & 0x0f);
+}
+
+// === µ-law (G.711) ===
+#define ULAW_BIAS 0x84
+#define ULAW_CLIP 32635
+
+uint8_t ulaw_encode(int16_t s) {
+    int32_t v = s;
+    uint8_t sign = 0;
+    if (v < 0) {
+        sign = 0x80;
+        v = -v;
+    }
+    if (v > ULAW_CLIP) v = ULAW_CLIP;
+    v += ULAW_BIAS;
+
+    // Sem CLZ no M0+: procura o bit mais alto de 14 a 7
+    uint8_t exponent = 7;
+    for (int32_t mask = 0x4000; !(v & mask) && exponent > 0; mask >>= 1) {
+        exponent--;
+    }
+    uint8_t mantissa = (v >> (exponent + 3)) & 0x0f;
+    return ~(sign | (exponent << 4) | mantissa);
+}
+
+int16_t ulaw_decode(uint8_t u) {
+    u = ~u;
+    uint8_t exponent = (u >> 4) & 0x07;
+    int32_t v = ((((int32_t)u & 0x0f) << 3) + ULAW_BIAS) << exponent;
+    v -= ULAW_BIAS;
+    return (u & 0x80) ? -v : v;
+}
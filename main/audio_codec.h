@@ -0,0 +1,24 @@
+#ifndef AUDIO_CODEC_H
+#define AUDIO_CODEC_H
+
+#include <stdint.h>
+
+// IMA-ADPCM 4 bits e µ-law 8 bits em ponto fixo (M0+ não tem FPU).
+// As amostras são lineares de 16 bits com sinal.
+
+typedef struct {
+    int16_t predictor;
+    uint8_t index;
+} adpcm_state_t;
+
+// n amostras <-> (n + 1) / 2 bytes, nibble baixo primeiro.
+// O estado segue de uma chamada para a outra, então blocos que chegam
+// em sequência formam um único fluxo.
+void adpcm_encode(adpcm_state_t *st, const int16_t *in, uint32_t n, uint8_t *out);
+void adpcm_decode(adpcm_state_t *st, const uint8_t *in, uint32_t n, int16_t *out);
+int16_t adpcm_decode_nibble(adpcm_state_t *st, uint8_t code);
+
+uint8_t ulaw_encode(int16_t s);
+int16_t ulaw_decode(uint8_t u);
+
+#endif
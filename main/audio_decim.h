@@ -0,0 +1,22 @@
+#ifndef AUDIO_DECIM_H
+#define AUDIO_DECIM_H
+
+#include <stdint.h>
+
+// Decimação por 8 (64 kHz -> 8 kHz): CIC de 3ª ordem seguido de um FIR
+// simétrico de 9 taps que compensa a queda do CIC até ~3,2 kHz.
+// Só inteiros; entrada e saída são amostras de 12 bits do ADC.
+#define DECIM_R 8
+#define DECIM_FIR_TAPS 9
+
+typedef struct {
+    uint32_t integ[3];
+    uint32_t comb[3];
+    int16_t hist[DECIM_FIR_TAPS];
+} audio_decim_t;
+
+void audio_decim_reset(audio_decim_t *d);
+// n_in múltiplo de DECIM_R; escreve n_in / DECIM_R amostras em out
+void audio_decim_process(audio_decim_t *d, const uint16_t *in, uint32_t n_in, uint16_t *out);
+
+#endif
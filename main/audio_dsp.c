@@ -0,0 +1,128 @@
+#include "audio_dsp.h"
+
+#include "pico/platform.h"
+
+#define DC_SHIFT 8
+#define AGC_RELEASE_SHIFT 3
+
+static inline int16_t sat16(int32_t v) {
+    if (v > 32767) return 32767;
+    if (v < -32768) return -32768;
+    return v;
+}
+
+void dsp_pipeline_init(dsp_pipeline_t *p) {
+    p->n = 0;
+}
+
+void dsp_pipeline_add(dsp_pipeline_t *p, dsp_stage_fn fn, void *state) {
+    if (p->n >= DSP_MAX_STAGES) return;
+    p->fn[p->n] = fn;
+    p->state[p->n] = state;
+    p->n++;
+}
+
+void dsp_pipeline_run(const dsp_pipeline_t *p, int16_t *buf, uint32_t n) {
+    for (uint8_t i = 0; i < p->n; i++) p->fn[i](p->state[i], buf, n);
+}
+
+void dsp_from_adc(const uint16_t *in, int16_t *out, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) out[i] = ((int32_t)in[i] - 2048) << 4;
+}
+
+void dsp_to_adc(const int16_t *in, uint16_t *out, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) out[i] = ((int32_t)in[i] + 32768) >> 4;
+}
+
+// === DC blocker ===
+void dsp_dc_init(dsp_dc_t *st) {
+    st->dc = 0;
+}
+
+void __not_in_flash_func(dsp_dc_process)(void *state, int16_t *buf, uint32_t n) {
+    dsp_dc_t *st = state;
+    int32_t dc = st->dc;
+    for (uint32_t i = 0; i < n; i++) {
+        int32_t x = buf[i];
+        dc += ((x << 12) - dc) >> DC_SHIFT;
+        buf[i] = sat16(x - (dc >> 12));
+    }
+    st->dc = dc;
+}
+
+// === Biquad ===
+void dsp_biquad_init(dsp_biquad_t *st, int16_t b0, int16_t b1, int16_t b2,
+                     int16_t a1, int16_t a2) {
+    st->b0 = b0;
+    st->b1 = b1;
+    st->b2 = b2;
+    st->a1 = a1;
+    st->a2 = a2;
+    st->x1 = st->x2 = st->y1 = st->y2 = 0;
+}
+
+void __not_in_flash_func(dsp_biquad_process)(void *state, int16_t *buf, uint32_t n) {
+    dsp_biquad_t *st = state;
+    int32_t x1 = st->x1, x2 = st->x2, y1 = st->y1, y2 = st->y2;
+
+    for (uint32_t i = 0; i < n; i++) {
+        int32_t x0 = buf[i];
+        // Somas parciais podem estourar 32 bits, mas o resultado final
+        // cabe: em aritmética modular o estouro se cancela
+        uint32_t acc = (uint32_t)(st->b0 * x0) + (uint32_t)(st->b1 * x1) +
+                       (uint32_t)(st->b2 * x2) - (uint32_t)(st->a1 * y1) -
+                       (uint32_t)(st->a2 * y2);
+        int16_t y0 = sat16(((int32_t)acc + (1 << 13)) >> 14);
+
+        x2 = x1;
+        x1 = x0;
+        y2 = y1;
+        y1 = y0;
+        buf[i] = y0;
+    }
+
+    st->x1 = x1;
+    st->x2 = x2;
+    st->y1 = y1;
+    st->y2 = y2;
+}
+
+// === AGC ===
+void dsp_agc_init(dsp_agc_t *st, uint16_t target, uint16_t max_gain_q8) {
+    st->target = target;
+    st->max_gain = max_gain_q8;
+    st->gain = 256;
+}
+
+void __not_in_flash_func(dsp_agc_process)(void *state, int16_t *buf, uint32_t n) {
+    dsp_agc_t *st = state;
+    if (n == 0) return;
+
+    int32_t peak = 1;
+    for (uint32_t i = 0; i < n; i++) {
+        int32_t a = buf[i] < 0 ? -buf[i] : buf[i];
+        if (a > peak) peak = a;
+    }
+
+    // Uma divisão por bloco (divisor de hardware do RP2040)
+    int32_t want = ((int32_t)st->target << 8) / peak;
+    if (want > st->max_gain) want = st->max_gain;
+
+    int32_t g0 = st->gain;
+    int32_t g1;
+    if (want < g0) {
+        // Ataque: aplica já no bloco inteiro para não saturar
+        g0 = g1 = want;
+    } else {
+        g1 = g0 + ((want - g0) >> AGC_RELEASE_SHIFT);
+    }
+
+    // Rampa linear de g0 a g1 ao longo do bloco, sem degrau audível
+    int32_t step = ((g1 - g0) << 16) / (int32_t)n;
+    int32_t g = g0 << 16;
+    for (uint32_t i = 0; i < n; i++) {
+        g += step;
+        buf[i] = sat16((buf[i] * (g >> 16)) >> 8);
+    }
+    st->gain = g1;
+}
@@ -0,0 +1,59 @@
+#ifndef AUDIO_DSP_H
+#define AUDIO_DSP_H
+
+#include <stdint.h>
+
+// Condicionamento em blocos, in-place, só com inteiros. As amostras
+// são Q15 (int16 com sinal); cada estágio tem um estado próprio e o
+// pipeline roda os estágios em sequência sobre o mesmo bloco.
+
+typedef void (*dsp_stage_fn)(void *state, int16_t *buf, uint32_t n);
+
+#define DSP_MAX_STAGES 6
+
+typedef struct {
+    dsp_stage_fn fn[DSP_MAX_STAGES];
+    void *state[DSP_MAX_STAGES];
+    uint8_t n;
+} dsp_pipeline_t;
+
+void dsp_pipeline_init(dsp_pipeline_t *p);
+void dsp_pipeline_add(dsp_pipeline_t *p, dsp_stage_fn fn, void *state);
+void dsp_pipeline_run(const dsp_pipeline_t *p, int16_t *buf, uint32_t n);
+
+// Amostras de 12 bits do ADC <-> Q15
+void dsp_from_adc(const uint16_t *in, int16_t *out, uint32_t n);
+void dsp_to_adc(const int16_t *in, uint16_t *out, uint32_t n);
+
+// === DC blocker: subtrai a média móvel de um polo (~5 Hz a 8 kHz) ===
+typedef struct {
+    int32_t dc;  // Q12
+} dsp_dc_t;
+
+void dsp_dc_init(dsp_dc_t *st);
+void dsp_dc_process(void *state, int16_t *buf, uint32_t n);
+
+// === Biquad (forma direta I), coeficientes Q14 com a0 = 1 ===
+typedef struct {
+    int16_t b0, b1, b2, a1, a2;
+    int16_t x1, x2, y1, y2;
+} dsp_biquad_t;
+
+// Passa-altas Butterworth de 100 Hz a 8 kHz (RBJ)
+#define DSP_HPF_100HZ_8K 15499, -30998, 15499, -30950, 14662
+
+void dsp_biquad_init(dsp_biquad_t *st, int16_t b0, int16_t b1, int16_t b2,
+                     int16_t a1, int16_t a2);
+void dsp_biquad_process(void *state, int16_t *buf, uint32_t n);
+
+// === AGC: ganho por bloco, ataque imediato e liberação lenta ===
+typedef struct {
+    uint16_t target;    // pico desejado (Q15)
+    uint16_t max_gain;  // Q8
+    uint16_t gain;      // Q8
+} dsp_agc_t;
+
+void dsp_agc_init(dsp_agc_t *st, uint16_t target, uint16_t max_gain_q8);
+void dsp_agc_process(void *state, int16_t *buf, uint32_t n);
+
+#endif
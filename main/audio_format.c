@@ -0,0 +1,156 @@
+#include "audio_format.h"
+#include "audio_codec.h"
+
+// 12 bits sem sinal <-> 16 bits com sinal para os codecs
+#define TO_S16(s) ((int16_t)(((int32_t)(s) - 2048) << 4))
+
+static inline uint16_t s16_to_level(int16_t v) {
+    return ((int32_t)v + 32768) >> 4;
+}
+
+// Passo do quantizador segue entre quadros para não recomeçar grosseiro
+static adpcm_state_t adpcm_enc;
+
+uint32_t audio_format_bytes(audio_format_t fmt, uint32_t n) {
+    return AUDIO_FORMAT_BYTES(fmt, n);
+}
+
+uint16_t audio_format_pwm_wrap(audio_format_t fmt) {
+    // Acima de 12 bits a portadora cairia na faixa audível, então o
+    // U16 toca com a mesma resolução do ADC
+    return fmt == AUDIO_FMT_U8 ? 255 : 4095;
+}
+
+void audio_format_pack(audio_format_t fmt, const uint16_t *in, uint32_t n, uint8_t *out) {
+    uint32_t i = 0;
+
+    switch (fmt) {
+    case AUDIO_FMT_U8:
+        for (; i < n; i++) out[i] = in[i] >> 4;
+        break;
+
+    case AUDIO_FMT_PACKED12:
+        // a = in[i], b = in[i+1] -> aaaaaaaa bbbbaaaa bbbbbbbb
+        for (; i + 1 < n; i += 2) {
+            uint16_t a = in[i] & 0xfff;
+            uint16_t b = in[i + 1] & 0xfff;
+            *out++ = a;
+            *out++ = (a >> 8) | (b << 4);
+            *out++ = b >> 4;
+        }
+        if (i < n) {
+            uint16_t a = in[i] & 0xfff;
+            *out++ = a;
+            *out = a >> 8;
+        }
+        break;
+
+    case AUDIO_FMT_U16:
+        for (; i < n; i++) {
+            uint16_t s = in[i] << 4;
+            out[2 * i] = s;
+            out[2 * i + 1] = s >> 8;
+        }
+        break;
+
+    case AUDIO_FMT_ULAW:
+        for (; i < n; i++) out[i] = ulaw_encode(TO_S16(in[i]));
+        break;
+
+    case AUDIO_FMT_ADPCM:
+        // Cada quadro recomeça do preditor na primeira amostra, gravado
+        // no cabeçalho para o quadro decodificar sozinho
+        while (i < n) {
+            int16_t frame[AUDIO_FORMAT_FRAME];
+            uint32_t len = n - i;
+            if (len > AUDIO_FORMAT_FRAME) len = AUDIO_FORMAT_FRAME;
+            for (uint32_t k = 0; k < len; k++) frame[k] = TO_S16(in[i + k]);
+
+            adpcm_state_t *st = &adpcm_enc;
+            st->predictor = frame[0];
+            out[0] = st->predictor;
+            out[1] = (uint16_t)st->predictor >> 8;
+            out[2] = st->index;
+            out[3] = 0;
+            adpcm_encode(st, frame, len, out + AUDIO_FORMAT_ADPCM_HEADER);
+
+            out += AUDIO_FORMAT_ADPCM_HEADER + (len + 1) / 2;
+            i += len;
+        }
+        break;
+    }
+}
+
+static uint16_t packed12_get(const uint8_t *buf, uint32_t idx) {
+    const uint8_t *p = buf + (idx >> 1) * 3;
+    if (idx & 1) return (p[1] >> 4) | (p[2] << 4);
+    return p[0] | ((p[1] & 0x0f) << 8);
+}
+
+void audio_format_to_levels(audio_format_t fmt, const uint8_t *buf, uint32_t first,
+                            uint32_t n, uint16_t *levels) {
+    uint32_t i = 0;
+
+    switch (fmt) {
+    case AUDIO_FMT_U8:
+        for (; i < n; i++) levels[i] = buf[first + i];
+        break;
+
+    case AUDIO_FMT_PACKED12:
+        // Alinha em amostra par e desempacota de dois em dois
+        if (first & 1 && n > 0) levels[i++] = packed12_get(buf, first);
+        {
+            const uint8_t *p = buf + ((first + i) >> 1) * 3;
+            for (; i + 1 < n; i += 2, p += 3) {
+                levels[i] = p[0] | ((p[1] & 0x0f) << 8);
+                levels[i + 1] = (p[1] >> 4) | (p[2] << 4);
+            }
+        }
+        if (i < n) levels[i] = packed12_get(buf, first + i);
+        break;
+
+    case AUDIO_FMT_U16:
+        for (; i < n; i++) {
+            const uint8_t *p = buf + 2 * (first + i);
+            levels[i] = (p[0] | (p[1] << 8)) >> 4;
+        }
+        break;
+
+    case AUDIO_FMT_ULAW:
+        for (; i < n; i++) levels[i] = s16_to_level(ulaw_decode(buf[first + i]));
+        break;
+
+    case AUDIO_FMT_ADPCM:
+        while (i < n) {
+            uint32_t pos = first + i;
+            uint32_t frame = pos / AUDIO_FORMAT_FRAME;
+            uint32_t skip = pos % AUDIO_FORMAT_FRAME;
+            const uint8_t *p = buf + frame * (AUDIO_FORMAT_ADPCM_HEADER + AUDIO_FORMAT_FRAME / 2);
+
+            adpcm_state_t st;
+            st.predictor = (int16_t)(p[0] | (p[1] << 8));
+            st.index = p[2];
+            p += AUDIO_FORMAT_ADPCM_HEADER;
+
+            // Início fora do quadro: decodifica e descarta até pos
+            for (uint32_t k = 0; k < skip; k++) {
+                adpcm_decode_nibble(&st, (k & 1) ? p[k >> 1] >> 4 : p[k >> 1]);
+            }
+
+            uint32_t len = AUDIO_FORMAT_FRAME - skip;
+            if (len > n - i) len = n - i;
+            if (skip == 0) {
+                int16_t out[AUDIO_FORMAT_FRAME];
+                adpcm_decode(&st, p, len, out);
+                for (uint32_t k = 0; k < len; k++) levels[i + k] = s16_to_level(out[k]);
+            } else {
+                for (uint32_t k = skip; k < skip + len; k++) {
+                    uint8_t code = (k & 1) ? p[k >> 1] >> 4 : p[k >> 1];
+                    levels[i + k - skip] = s16_to_level(adpcm_decode_nibble(&st, code));
+                }
+            }
+            i += len;
+        }
+        break;
+    }
+}
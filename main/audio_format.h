@@ -0,0 +1,44 @@
+#ifndef AUDIO_FORMAT_H
+#define AUDIO_FORMAT_H
+
+#include <stdint.h>
+
+// Formatos de armazenamento das amostras de 12 bits do ADC
+typedef enum {
+    AUDIO_FMT_U8,        // 8 bits sem sinal (descarta 4 LSBs)
+    AUDIO_FMT_PACKED12,  // 12 bits, 2 amostras a cada 3 bytes
+    AUDIO_FMT_U16,       // 16 bits sem sinal, alinhado à esquerda
+    AUDIO_FMT_ULAW,      // µ-law, 8 bits por amostra
+    AUDIO_FMT_ADPCM,     // IMA-ADPCM, 4 bits por amostra em quadros
+} audio_format_t;
+
+// No ADPCM cada quadro começa com o estado do preditor (4 bytes), então
+// pack e to_levels devem começar em múltiplos de AUDIO_FORMAT_FRAME
+#define AUDIO_FORMAT_FRAME 256
+#define AUDIO_FORMAT_ADPCM_HEADER 4
+
+// Bytes para n amostras; expressão constante para dimensionar buffers
+#define AUDIO_FORMAT_BYTES(fmt, n)                                        \
+    ((fmt) == AUDIO_FMT_U8       ? (n) :                                  \
+     (fmt) == AUDIO_FMT_PACKED12 ? ((n) * 3 + 1) / 2 :                    \
+     (fmt) == AUDIO_FMT_U16      ? (n) * 2 :                              \
+     (fmt) == AUDIO_FMT_ULAW     ? (n) :                                  \
+     ((n) / AUDIO_FORMAT_FRAME) *                                         \
+         (AUDIO_FORMAT_ADPCM_HEADER + AUDIO_FORMAT_FRAME / 2) +           \
+     ((n) % AUDIO_FORMAT_FRAME ?                                          \
+         AUDIO_FORMAT_ADPCM_HEADER + ((n) % AUDIO_FORMAT_FRAME + 1) / 2 : 0))
+
+uint32_t audio_format_bytes(audio_format_t fmt, uint32_t n);
+
+// Wrap de PWM que reproduz o formato na resolução armazenada
+uint16_t audio_format_pwm_wrap(audio_format_t fmt);
+
+// Empacota n amostras de 12 bits em out; no PACKED12 o bloco começa
+// sempre em amostra par e no ADPCM em início de quadro
+void audio_format_pack(audio_format_t fmt, const uint16_t *in, uint32_t n, uint8_t *out);
+
+// Converte n amostras a partir do índice first em níveis de PWM
+void audio_format_to_levels(audio_format_t fmt, const uint8_t *buf, uint32_t first,
+                            uint32_t n, uint16_t *levels);
+
+#endif
@@ -0,0 +1,226 @@
+#include "audio_play.h"
+
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/pwm.h"
+#include "hardware/interp.h"
+
+// Saída sobreamostrada: PLAY_UPSAMPLE x a taxa da fonte, quantizada com
+// noise shaping para PLAY_SHAPED_BITS (portadora de ~244 kHz a 125 MHz)
+#define PLAY_UPSAMPLE 4
+#define PLAY_SHAPED_BITS 9
+#define PLAY_SHAPED_WRAP ((1 << PLAY_SHAPED_BITS) - 1)
+#define PLAY_SHAPED_LSB (1 << (16 - PLAY_SHAPED_BITS))
+
+static uint16_t levels[2][AUDIO_PLAY_BLOCK];
+
+static uint out_pin;
+static uint slice;
+static int dma_ch[2] = {-1, -1};
+static dma_channel_config dma_cfg[2];
+static int dma_timer = -1;
+static uint16_t idle_level = 128;
+static uint play_rate;
+static uint16_t src_wrap = 255;
+
+static bool upsampling = false;
+static uint8_t src_bits = 8;
+static uint16_t src_buf[AUDIO_PLAY_BLOCK / PLAY_UPSAMPLE];
+static uint32_t prev_sample;
+static int32_t shape_err;
+
+static audio_play_source_t source = NULL;
+static audio_play_done_cb_t done_cb = NULL;
+static volatile bool playing = false;
+static volatile int last_ch = -1;
+
+// Melhor fração x/y (16 bits cada) para rate = sys_hz * x / y
+static void timer_fraction(uint32_t sys_hz, uint32_t rate, uint16_t *x, uint16_t *y) {
+    uint64_t best_err = UINT64_MAX;
+    uint32_t max_x = (uint32_t)((uint64_t)0xffff * rate / sys_hz);
+    if (max_x == 0) max_x = 1;
+    for (uint32_t xi = 1; xi <= max_x && xi <= 0xffff; xi++) {
+        uint64_t num = (uint64_t)xi * sys_hz;
+        uint64_t yi = (num + rate / 2) / rate;
+        if (yi == 0 || yi > 0xffff) continue;
+        // Erro relativo |x/y - rate/sys| em ponto fixo
+        uint64_t diff = num > yi * rate ? num - yi * rate : yi * rate - num;
+        uint64_t err = diff * 0x10000 / yi;
+        if (err < best_err) {
+            best_err = err;
+            *x = xi;
+            *y = yi;
+            if (diff == 0) break;
+        }
+    }
+}
+
+static void finish(void) {
+    pwm_set_gpio_level(out_pin, idle_level);
+    pwm_set_enabled(slice, false);
+    playing = false;
+    if (done_cb) done_cb();
+}
+
+// Interpolação linear 4x no interpolador 0 (modo blend) e noise
+// shaping de 1ª ordem: o erro de quantização vai para a próxima amostra
+// e o ruído sobe para acima da banda de áudio
+static uint32_t fill_upsampled(uint16_t *out, uint32_t n_out) {
+    uint32_t n_in = source(src_buf, n_out / PLAY_UPSAMPLE);
+    if (n_in == 0) return 0;
+
+    // A IRQ pode interromper outro uso do interp0 neste core
+    interp_hw_save_t saved;
+    interp_save(interp0, &saved);
+    interp_config cfg = interp_default_config();
+    interp_config_set_blend(&cfg, true);
+    interp_set_config(interp0, 0, &cfg);
+    cfg = interp_default_config();
+    interp_set_config(interp0, 1, &cfg);
+
+    uint shift = 16 - src_bits;
+    int32_t err = shape_err;
+    for (uint32_t i = 0; i < n_in; i++) {
+        interp0->base[0] = prev_sample << shift;
+        interp0->base[1] = (uint32_t)src_buf[i] << shift;
+        for (uint k = 0; k < PLAY_UPSAMPLE; k++) {
+            interp0->accum[1] = k * (256 / PLAY_UPSAMPLE);
+            int32_t v = (int32_t)interp0->peek[1] + err;
+            int32_t q = v / PLAY_SHAPED_LSB;
+            if (q < 0) q = 0;
+            else if (q > PLAY_SHAPED_WRAP) q = PLAY_SHAPED_WRAP;
+            // Erro limitado a 1 LSB para não acumular quando satura
+            err = v - q * PLAY_SHAPED_LSB;
+            if (err > PLAY_SHAPED_LSB) err = PLAY_SHAPED_LSB;
+            else if (err < -PLAY_SHAPED_LSB) err = -PLAY_SHAPED_LSB;
+            *out++ = q;
+        }
+        prev_sample = src_buf[i];
+    }
+    shape_err = err;
+
+    interp_restore(interp0, &saved);
+    return n_in * PLAY_UPSAMPLE;
+}
+
+// Reabastece o bloco i; sem mais amostras, o bloco vira um nível de
+// repouso e o canal para de encadear no outro.
+static void refill(int i) {
+    uint32_t n = upsampling ? fill_upsampled(levels[i], AUDIO_PLAY_BLOCK)
+                            : source(levels[i], AUDIO_PLAY_BLOCK);
+    if (n == 0) {
+        levels[i][0] = idle_level;
+        n = 1;
+        channel_config_set_chain_to(&dma_cfg[i], dma_ch[i]);
+        dma_channel_set_config(dma_ch[i], &dma_cfg[i], false);
+        last_ch = i;
+    }
+    dma_channel_set_read_addr(dma_ch[i], levels[i], false);
+    dma_channel_set_trans_count(dma_ch[i], n, false);
+}
+
+static void play_dma_handler(void) {
+    for (int i = 0; i < 2; i++) {
+        if (!dma_channel_get_irq1_status(dma_ch[i])) continue;
+        dma_channel_acknowledge_irq1(dma_ch[i]);
+
+        if (!playing) continue;
+        if (last_ch == i) {
+            finish();
+        } else if (last_ch < 0) {
+            refill(i);
+        }
+    }
+}
+
+// Wrap, nível de repouso e taxa do timer conforme o modo de saída
+static void apply_output_config(void) {
+    uint16_t wrap = upsampling ? PLAY_SHAPED_WRAP : src_wrap;
+    pwm_set_wrap(slice, wrap);
+    idle_level = (wrap + 1) / 2;
+
+    // Taxa do timer = clk_sys * x / y
+    uint16_t x = 1, y = 0xffff;
+    timer_fraction(clock_get_hz(clk_sys),
+                   upsampling ? play_rate * PLAY_UPSAMPLE : play_rate, &x, &y);
+    dma_timer_set_fraction(dma_timer, x, y);
+}
+
+void audio_play_init(uint pin, uint sample_rate) {
+    out_pin = pin;
+    gpio_set_function(pin, GPIO_FUNC_PWM);
+    slice = pwm_gpio_to_slice_num(pin);
+
+    pwm_config config = pwm_get_default_config();
+    pwm_config_set_wrap(&config, 255); // ajustado em apply_output_config
+    pwm_config_set_clkdiv(&config, 1.0f);
+    pwm_init(slice, &config, false);
+
+    play_rate = sample_rate;
+    dma_timer = dma_claim_unused_timer(true);
+    apply_output_config();
+
+    for (int i = 0; i < 2; i++) {
+        dma_ch[i] = dma_claim_unused_channel(true);
+        dma_channel_set_irq1_enabled(dma_ch[i], true);
+    }
+    irq_add_shared_handler(DMA_IRQ_1, play_dma_handler,
+                           PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_1, true);
+}
+
+void audio_play_set_wrap(uint16_t wrap) {
+    src_wrap = wrap;
+    src_bits = 0;
+    while (src_bits < 16 && (1u << src_bits) <= wrap) src_bits++;
+    apply_output_config();
+}
+
+void audio_play_set_upsampling(bool on) {
+    upsampling = on;
+    apply_output_config();
+}
+
+void audio_play_start(audio_play_source_t src, audio_play_done_cb_t cb) {
+    source = src;
+    done_cb = cb;
+    last_ch = -1;
+    prev_sample = (src_wrap + 1) / 2;
+    shape_err = 0;
+
+    // Escrita de 16 bits no CC é replicada nas duas metades (canais A e B)
+    volatile uint32_t *cc = &pwm_hw->slice[slice].cc;
+    for (int i = 0; i < 2; i++) {
+        dma_cfg[i] = dma_channel_get_default_config(dma_ch[i]);
+        channel_config_set_transfer_data_size(&dma_cfg[i], DMA_SIZE_16);
+        channel_config_set_read_increment(&dma_cfg[i], true);
+        channel_config_set_write_increment(&dma_cfg[i], false);
+        channel_config_set_dreq(&dma_cfg[i], dma_get_timer_dreq(dma_timer));
+        channel_config_set_chain_to(&dma_cfg[i], dma_ch[i ^ 1]);
+        dma_channel_configure(dma_ch[i], &dma_cfg[i], cc, levels[i],
+                              AUDIO_PLAY_BLOCK, false);
+        refill(i);
+        if (last_ch >= 0) break;
+    }
+
+    playing = true;
+    pwm_set_gpio_level(out_pin, idle_level);
+    pwm_set_enabled(slice, true);
+    dma_channel_start(dma_ch[0]);
+}
+
+void audio_play_stop(void) {
+    // Abortar pode gerar IRQ espúria (errata RP2040-E13)
+    for (int i = 0; i < 2; i++) {
+        dma_channel_set_irq1_enabled(dma_ch[i], false);
+        dma_channel_abort(dma_ch[i]);
+        dma_channel_acknowledge_irq1(dma_ch[i]);
+        dma_channel_set_irq1_enabled(dma_ch[i], true);
+    }
+    if (playing) finish();
+}
+
+bool audio_play_busy(void) {
+    return playing;
+}
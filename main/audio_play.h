@@ -0,0 +1,28 @@
+#ifndef AUDIO_PLAY_H
+#define AUDIO_PLAY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+
+// Níveis de PWM por bloco do ping-pong de saída
+#define AUDIO_PLAY_BLOCK 256
+
+// Preenche até n níveis de PWM; retornar 0 encerra a reprodução.
+// Roda dentro da IRQ do DMA.
+typedef uint32_t (*audio_play_source_t)(uint16_t *levels, uint32_t n);
+typedef void (*audio_play_done_cb_t)(void);
+
+// DMA escreve os níveis no registrador CC do slice, cadenciado por um
+// timer de DMA em sample_rate; a CPU só reabastece os blocos.
+void audio_play_init(uint pin, uint sample_rate);
+// Resolução dos níveis da fonte; o silêncio fica no meio da escala
+void audio_play_set_wrap(uint16_t wrap);
+// Interpola 4x (interpolador de hardware) e aplica noise shaping para
+// um PWM de 9 bits e portadora mais alta; vale a partir do próximo start
+void audio_play_set_upsampling(bool on);
+void audio_play_start(audio_play_source_t src, audio_play_done_cb_t cb);
+void audio_play_stop(void);
+bool audio_play_busy(void);
+
+#endif
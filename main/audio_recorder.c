@@ -0,0 +1,201 @@
+#include "audio_recorder.h"
+
+#include <string.h>
+
+#include "audio_capture.h"
+#include "audio_play.h"
+#if AUDIO_DSP_CORE1
+#include "audio_worker.h"
+#endif
+
+static audio_format_t format;
+static uint8_t *ring;
+static uint32_t block_bytes;
+static uint32_t n_blocks;
+static uint32_t rate;
+static StreamBufferHandle_t stream;
+static const dsp_pipeline_t *pipeline = NULL;
+static const audio_vad_t *gate = NULL;
+
+static volatile audio_recorder_state_t state = REC_IDLE;
+
+// Índices de bloco monotônicos; a posição no anel é índice % n_blocks.
+// consumed conta blocos recebidos e head os guardados (diferem com gate).
+static uint32_t head;
+static uint32_t consumed;
+static uint32_t pre_blocks;
+static uint32_t post_blocks;
+static uint32_t trigger_at;
+static uint32_t trigger_head;
+static uint32_t clip_first;
+static uint32_t clip_end;
+
+static volatile uint32_t play_block;
+static volatile uint32_t play_off;
+
+static uint32_t ms_to_blocks(uint32_t ms) {
+    uint32_t samples = ms * rate / 1000;
+    return (samples + AUDIO_BLOCK_SAMPLES - 1) / AUDIO_BLOCK_SAMPLES;
+}
+
+// Fonte da reprodução: percorre o clipe no anel (roda na IRQ do DMA)
+static uint32_t ring_source(uint16_t *levels, uint32_t n) {
+    if (play_block >= clip_end) return 0;
+
+    uint32_t left = AUDIO_BLOCK_SAMPLES - play_off;
+    if (n > left) n = left;
+    audio_format_to_levels(format, ring + (play_block % n_blocks) * block_bytes,
+                           play_off, n, levels);
+
+    play_off += n;
+    if (play_off == AUDIO_BLOCK_SAMPLES) {
+        play_off = 0;
+        play_block++;
+    }
+    return n;
+}
+
+static void play_done(void) {
+    state = REC_IDLE;
+}
+
+void audio_recorder_init(audio_format_t fmt, uint8_t *mem, uint32_t mem_bytes,
+                         uint32_t sample_rate, StreamBufferHandle_t sb) {
+    format = fmt;
+    ring = mem;
+    rate = sample_rate;
+    stream = sb;
+    block_bytes = audio_format_bytes(fmt, AUDIO_BLOCK_SAMPLES);
+    n_blocks = mem_bytes / block_bytes;
+#if AUDIO_DSP_CORE1
+    audio_worker_start(fmt);
+#endif
+}
+
+void audio_recorder_set_pipeline(const dsp_pipeline_t *p) {
+    pipeline = p;
+#if AUDIO_DSP_CORE1
+    audio_worker_set_pipeline(pipeline, gate);
+#endif
+}
+
+void audio_recorder_set_gate(const audio_vad_t *vad) {
+    gate = vad;
+#if AUDIO_DSP_CORE1
+    audio_worker_set_pipeline(pipeline, gate);
+#endif
+}
+
+void audio_recorder_arm(uint32_t pre_ms, uint32_t post_ms) {
+    post_blocks = ms_to_blocks(post_ms);
+    if (post_blocks > n_blocks) post_blocks = n_blocks;
+    // Janela maior que o anel: sacrifica o pré-trigger
+    pre_blocks = ms_to_blocks(pre_ms);
+    if (pre_blocks > n_blocks - post_blocks) pre_blocks = n_blocks - post_blocks;
+
+#if AUDIO_DSP_CORE1
+    // Blocos que sobraram no núcleo 1 são da gravação anterior
+    audio_worker_flush();
+#endif
+    head = 0;
+    consumed = 0;
+    state = REC_ARMED;
+    xStreamBufferReset(stream);
+    audio_capture_stream_start(stream);
+}
+
+void audio_recorder_trigger(void) {
+    if (state != REC_ARMED) return;
+
+    // Blocos ainda no stream (ou no núcleo 1) foram capturados antes do trigger
+    trigger_at = consumed + xStreamBufferBytesAvailable(stream) / AUDIO_BLOCK_BYTES;
+#if AUDIO_DSP_CORE1
+    trigger_at += audio_worker_in_flight();
+#endif
+    trigger_head = head;
+    state = REC_TRIGGERED;
+}
+
+static void freeze(void) {
+    audio_capture_stop();
+    clip_end = head;
+    clip_first = trigger_head > pre_blocks ? trigger_head - pre_blocks : 0;
+    if (clip_end - clip_first > n_blocks) clip_first = clip_end - n_blocks;
+    state = REC_FROZEN;
+}
+
+#if AUDIO_DSP_CORE1
+// Guarda o bloco consumido; packed NULL = descartado pelo gate
+static void store(const uint8_t *packed) {
+    if (state == REC_TRIGGERED && consumed == trigger_at) trigger_head = head;
+    consumed++;
+    if (packed) {
+        memcpy(ring + (head % n_blocks) * block_bytes, packed, block_bytes);
+        head++;
+    }
+    if (state == REC_TRIGGERED && consumed >= trigger_at + post_blocks) freeze();
+}
+
+// O núcleo 1 condiciona e codifica; aqui só se entrega e recolhe blocos
+audio_recorder_state_t audio_recorder_poll(void) {
+    bool progress = true;
+    while (progress && (state == REC_ARMED || state == REC_TRIGGERED)) {
+        progress = false;
+        uint16_t *slot;
+        while ((slot = audio_worker_slot()) &&
+               xStreamBufferBytesAvailable(stream) >= AUDIO_BLOCK_BYTES) {
+            xStreamBufferReceive(stream, slot, AUDIO_BLOCK_BYTES, 0);
+            audio_worker_submit();
+            progress = true;
+        }
+        const uint8_t *packed;
+        while ((state == REC_ARMED || state == REC_TRIGGERED) &&
+               audio_worker_collect(&packed)) {
+            store(packed);
+            audio_worker_release();
+            progress = true;
+        }
+    }
+    return state;
+}
+#else
+audio_recorder_state_t audio_recorder_poll(void) {
+    uint16_t bloco[AUDIO_BLOCK_SAMPLES];
+
+    while ((state == REC_ARMED || state == REC_TRIGGERED) &&
+           xStreamBufferBytesAvailable(stream) >= AUDIO_BLOCK_BYTES) {
+        xStreamBufferReceive(stream, bloco, AUDIO_BLOCK_BYTES, 0);
+        if (pipeline) {
+            // Condiciona in-place em Q15 antes de codificar
+            int16_t *q15 = (int16_t *)bloco;
+            dsp_from_adc(bloco, q15, AUDIO_BLOCK_SAMPLES);
+            dsp_pipeline_run(pipeline, q15, AUDIO_BLOCK_SAMPLES);
+            dsp_to_adc(q15, bloco, AUDIO_BLOCK_SAMPLES);
+        }
+        if (state == REC_TRIGGERED && consumed == trigger_at) trigger_head = head;
+        consumed++;
+
+        // Com gate, blocos em silêncio nem são codificados
+        if (!gate || gate->active) {
+            audio_format_pack(format, bloco, AUDIO_BLOCK_SAMPLES,
+                              ring + (head % n_blocks) * block_bytes);
+            head++;
+        }
+
+        if (state == REC_TRIGGERED && consumed >= trigger_at + post_blocks) freeze();
+    }
+    return state;
+}
+#endif
+
+void audio_recorder_play(void) {
+    if (state != REC_FROZEN) return;
+    play_block = clip_first;
+    play_off = 0;
+    state = REC_PLAYING;
+    audio_play_start(ring_source, play_done);
+}
+
+audio_recorder_state_t audio_recorder_state(void) {
+    return state;
+}
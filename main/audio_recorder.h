@@ -0,0 +1,39 @@
+#ifndef AUDIO_RECORDER_H
+#define AUDIO_RECORDER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "FreeRTOS.h"
+#include "stream_buffer.h"
+
+#include "audio_format.h"
+#include "audio_dsp.h"
+#include "audio_vad.h"
+
+typedef enum {
+    REC_IDLE,       // parado (ou reprodução terminou)
+    REC_ARMED,      // gravando no anel, esperando o trigger
+    REC_TRIGGERED,  // trigger recebido, completando o pós-trigger
+    REC_FROZEN,     // clipe congelado no anel, pronto para tocar
+    REC_PLAYING,
+} audio_recorder_state_t;
+
+// Grava continuamente num anel de blocos codificados em mem. No trigger
+// congela pre_ms antes e post_ms depois; a reprodução lê o clipe direto
+// do anel, sem cópia.
+void audio_recorder_init(audio_format_t fmt, uint8_t *mem, uint32_t mem_bytes,
+                         uint32_t sample_rate, StreamBufferHandle_t sb);
+// Estágios aplicados a cada bloco antes de ir para o anel (NULL desliga)
+void audio_recorder_set_pipeline(const dsp_pipeline_t *p);
+// Só guarda blocos em que vad->active; o VAD precisa estar no pipeline.
+// A janela pós-trigger segue contando tempo real, mesmo em silêncio.
+void audio_recorder_set_gate(const audio_vad_t *vad);
+void audio_recorder_arm(uint32_t pre_ms, uint32_t post_ms);
+void audio_recorder_trigger(void);
+// Drena o stream para o anel; chamar periodicamente
+audio_recorder_state_t audio_recorder_poll(void);
+void audio_recorder_play(void);
+audio_recorder_state_t audio_recorder_state(void);
+
+#endif
@@ -0,0 +1,100 @@
+#include "audio_task.h"
+
+// Dispara na subida de cada fonte, não no nível combinado: um som
+// contínuo não impede que um objeto que chega dispare outra gravação.
+// A subida fica pendente enquanto a fonte seguir ativa, para valer
+// quando o gravador voltar a armar.
+typedef struct {
+    bool perto;
+    bool som;
+    bool pendente;
+    bool por_objeto;  // a subida pendente veio da distância
+} trigger_t;
+
+static bool trigger_update(trigger_t *t, audio_trigger_modo_t modo, bool perto, bool som) {
+    bool sobe_perto = perto && !t->perto;
+    bool sobe_som = som && !t->som;
+    bool borda, nivel;
+    switch (modo) {
+    case AUDIO_TRIGGER_DISTANCIA:
+        borda = sobe_perto;
+        nivel = perto;
+        break;
+    case AUDIO_TRIGGER_SOM:
+        borda = sobe_som;
+        nivel = som;
+        break;
+    case AUDIO_TRIGGER_QUALQUER:
+        borda = sobe_perto || sobe_som;
+        nivel = perto || som;
+        break;
+    default:
+        borda = (sobe_perto && som) || (sobe_som && perto);
+        nivel = perto && som;
+        break;
+    }
+    t->perto = perto;
+    t->som = som;
+    if (borda) {
+        t->pendente = true;
+        t->por_objeto = sobe_perto;
+    }
+    if (!nivel) t->pendente = false;
+    return t->pendente;
+}
+
+// A reprodução roda no DMA e só precisa desta tarefa para começar e para
+// rearmar no fim. Com AUDIO_DSP_CORE1 o condicionamento e a codificação
+// vão para o núcleo 1 e o poll só move blocos entre o stream e o anel.
+void audio_task(void *p) {
+    audio_task_t *a = p;
+    const audio_io_t *io = a->io;
+    trigger_t trig = {false, false, false, false};
+
+    // Condicionamento: tira o bias de meio de escala, corta ruído de
+    // baixa frequência e normaliza o volume
+    dsp_pipeline_t cond;
+    dsp_dc_t dc;
+    dsp_biquad_t hpf;
+    dsp_agc_t agc;
+    audio_vad_t vad;
+    dsp_dc_init(&dc);
+    dsp_biquad_init(&hpf, DSP_HPF_100HZ_8K);
+    audio_vad_init(&vad);
+    dsp_agc_init(&agc, 16384, 32 * 256);  // pico em -6 dBFS, até 32x
+    dsp_pipeline_init(&cond);
+    dsp_pipeline_add(&cond, dsp_dc_process, &dc);
+    dsp_pipeline_add(&cond, dsp_biquad_process, &hpf);
+    // VAD antes do AGC, que achataria a diferença entre som e fundo
+    dsp_pipeline_add(&cond, audio_vad_process, &vad);
+    dsp_pipeline_add(&cond, dsp_agc_process, &agc);
+    io->set_pipeline(&cond);
+    if (a->gate) io->set_gate(&vad);
+
+    // Grava o tempo todo; o trigger só congela a janela
+    io->arm(a->pre_ms, a->post_ms);
+
+    while (true) {
+        // Acorda com o bloqueio ou a cada espera_ms para drenar
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(a->espera_ms));
+
+        if (trigger_update(&trig, a->modo, a->ranging->bloqueado, vad.active) &&
+            io->state() == REC_ARMED) {
+            io->trigger();
+            if (io->gravando) io->gravando(trig.por_objeto, &vad);
+            trig.pendente = false;
+        }
+
+        switch (io->poll()) {
+        case REC_FROZEN:
+            if (io->tocando) io->tocando();
+            io->play();
+            break;
+        case REC_IDLE:
+            io->arm(a->pre_ms, a->post_ms);
+            break;
+        default:
+            break;
+        }
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef AUDIO_TASK_H
+#define AUDIO_TASK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "audio_recorder.h"
+#include "ranging.h"
+
+// Fonte do trigger de gravação
+typedef enum {
+    AUDIO_TRIGGER_DISTANCIA,
+    AUDIO_TRIGGER_SOM,
+    AUDIO_TRIGGER_QUALQUER,  // distância ou som
+    AUDIO_TRIGGER_AMBOS,     // distância e som juntos
+} audio_trigger_modo_t;
+
+// O que a tarefa de áudio usa do gravador. No firmware são as funções de
+// audio_recorder; no teste de host, um gravador de mentira que roda o
+// pipeline sobre blocos sintéticos. Os ganchos de telemetria podem ser
+// NULL.
+typedef struct {
+    void (*set_pipeline)(const dsp_pipeline_t *p);
+    void (*set_gate)(const audio_vad_t *vad);
+    void (*arm)(uint32_t pre_ms, uint32_t post_ms);
+    void (*trigger)(void);
+    audio_recorder_state_t (*state)(void);
+    audio_recorder_state_t (*poll)(void);
+    void (*play)(void);
+    void (*gravando)(bool por_objeto, const audio_vad_t *vad);
+    void (*tocando)(void);
+} audio_io_t;
+
+// Configuração da tarefa; struct do chamador
+typedef struct {
+    const audio_io_t *io;
+    audio_trigger_modo_t modo;
+    bool gate;                  // blocos em silêncio não entram no anel
+    uint32_t pre_ms;            // janela congelada no trigger
+    uint32_t post_ms;
+    uint32_t espera_ms;         // prazo para drenar o stream sem aviso
+    const ranging_t *ranging;   // bloqueado é a fonte de distância
+} audio_task_t;
+
+// Condiciona e grava o tempo todo; dispara a gravação na subida de cada
+// fonte e toca o clipe congelado. p é o audio_task_t. A tarefa espera a
+// notificação de bloqueio (índice 0), com prazo de espera_ms.
+void audio_task(void *p);
+
+#endif
@@ -0,0 +1,77 @@
+#include "audio_vad.h"
+
+#include "pico/stdlib.h"
+
+// Energia em amostras de 12 bits (Q15 >> 4): soma de 256 quadrados cabe
+// em 32 bits
+#define VAD_SHIFT 4
+// Piso mínimo evita disparar com o ruído de quantização do ADC
+#define VAD_MIN_FLOOR 16
+// Acima de 4x o piso é som; entre 2x e 4x só se o ZCR parecer som
+#define VAD_STRONG_RATIO 4
+#define VAD_WEAK_RATIO 2
+// Cruzamentos por zero por bloco de 256 aceitos como som (~60 Hz a 2,5 kHz)
+#define VAD_ZCR_MIN 4
+#define VAD_ZCR_MAX 160
+// Mantém ativo por 4 blocos (~128 ms) para não cortar finais de palavra
+#define VAD_HANGOVER 4
+// Piso sobe 1/32 da diferença por bloco fora de atividade e 1/128
+// durante, sempre pelo menos 1: um fundo estável acima do limiar deixa
+// de ser som em poucos segundos em vez de travar o detector ativo
+#define VAD_RISE_SHIFT 5
+#define VAD_ACTIVE_RISE_SHIFT 7
+
+void audio_vad_init(audio_vad_t *v) {
+    v->floor = VAD_MIN_FLOOR;
+    v->hang_left = 0;
+    v->active = false;
+    v->blocks = 0;
+    v->active_blocks = 0;
+    v->cost_us_total = 0;
+    v->cost_us_max = 0;
+}
+
+void audio_vad_process(void *state, int16_t *buf, uint32_t n) {
+    audio_vad_t *v = state;
+    if (n == 0) return;
+    uint32_t t0 = time_us_32();
+
+    uint32_t sum = 0;
+    uint32_t zcr = 0;
+    int16_t last = buf[0];
+    for (uint32_t i = 0; i < n; i++) {
+        int32_t x = buf[i] >> VAD_SHIFT;
+        sum += x * x;
+        zcr += (buf[i] ^ last) < 0;
+        last = buf[i];
+    }
+    uint32_t energy = sum / n;
+
+    bool zcr_som = zcr >= VAD_ZCR_MIN && zcr <= VAD_ZCR_MAX;
+    bool som = energy > v->floor * VAD_STRONG_RATIO ||
+               (energy > v->floor * VAD_WEAK_RATIO && zcr_som);
+
+    if (som) {
+        v->hang_left = VAD_HANGOVER;
+        // Sobe bem mais devagar que fora de atividade: uma fala de alguns
+        // segundos ainda passa inteira, e as pausas devolvem o piso
+        if (energy > v->floor) v->floor += ((energy - v->floor) >> VAD_ACTIVE_RISE_SHIFT) + 1;
+    } else {
+        if (v->hang_left) v->hang_left--;
+        // Piso desce rápido e sobe devagar
+        if (energy < v->floor) v->floor -= (v->floor - energy) >> 2;
+        else if (energy > v->floor) v->floor += ((energy - v->floor) >> VAD_RISE_SHIFT) + 1;
+        if (v->floor < VAD_MIN_FLOOR) v->floor = VAD_MIN_FLOOR;
+    }
+    v->active = som || v->hang_left > 0;
+
+    uint32_t dt = time_us_32() - t0;
+    v->blocks++;
+    v->active_blocks += v->active;
+    v->cost_us_total += dt;
+    if (dt > v->cost_us_max) v->cost_us_max = dt;
+}
+
+uint32_t audio_vad_mean_cost_us(const audio_vad_t *v) {
+    return v->blocks ? v->cost_us_total / v->blocks : 0;
+}
@@ -0,0 +1,29 @@
+#ifndef AUDIO_VAD_H
+#define AUDIO_VAD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Detector de atividade sonora por bloco: energia média contra um piso
+// de ruído adaptativo, com a taxa de cruzamentos por zero separando som
+// de chiado quando a energia é só moderada. Entra no pipeline de DSP
+// como estágio que não altera o bloco.
+typedef struct {
+    uint32_t floor;      // energia do ruído de fundo
+    uint8_t hang_left;   // blocos que ainda contam como ativos
+    bool active;         // decisão do último bloco
+
+    // Instrumentação
+    uint32_t blocks;
+    uint32_t active_blocks;
+    uint32_t cost_us_total;
+    uint32_t cost_us_max;
+} audio_vad_t;
+
+void audio_vad_init(audio_vad_t *v);
+// dsp_stage_fn: state é um audio_vad_t, buf em Q15
+void audio_vad_process(void *state, int16_t *buf, uint32_t n);
+// Custo médio por bloco em µs
+uint32_t audio_vad_mean_cost_us(const audio_vad_t *v);
+
+#endif
@@ -0,0 +1,88 @@
+#include "audio_worker.h"
+
+#include "pico/multicore.h"
+
+// Cabe o maior formato (16 bits por amostra)
+#define WORKER_PACKED_MAX (AUDIO_BLOCK_SAMPLES * sizeof(uint16_t))
+// Bit na palavra de volta pela FIFO: o gate deixou o bloco passar
+#define WORKER_ACTIVE (1u << 8)
+
+static uint16_t raw[AUDIO_WORKER_SLOTS][AUDIO_BLOCK_SAMPLES];
+static uint8_t packed[AUDIO_WORKER_SLOTS][WORKER_PACKED_MAX];
+
+static audio_format_t format;
+static const dsp_pipeline_t *volatile pipeline = NULL;
+static const audio_vad_t *volatile gate = NULL;
+
+// Só o núcleo 0 mexe nos contadores; a posição no slot é contador % SLOTS
+static uint32_t submitted;
+static uint32_t collected;
+static uint32_t released;
+
+static void core1_main(void) {
+    while (true) {
+        uint32_t slot = multicore_fifo_pop_blocking();
+        uint16_t *bloco = raw[slot];
+        const dsp_pipeline_t *p = pipeline;
+        const audio_vad_t *g = gate;
+
+        if (p) {
+            // Condiciona in-place em Q15 antes de codificar
+            int16_t *q15 = (int16_t *)bloco;
+            dsp_from_adc(bloco, q15, AUDIO_BLOCK_SAMPLES);
+            dsp_pipeline_run(p, q15, AUDIO_BLOCK_SAMPLES);
+            dsp_to_adc(q15, bloco, AUDIO_BLOCK_SAMPLES);
+        }
+        // Com gate, blocos em silêncio nem são codificados
+        bool active = !g || g->active;
+        if (active) audio_format_pack(format, bloco, AUDIO_BLOCK_SAMPLES, packed[slot]);
+
+        multicore_fifo_push_blocking(slot | (active ? WORKER_ACTIVE : 0));
+    }
+}
+
+void audio_worker_start(audio_format_t fmt) {
+    format = fmt;
+    submitted = collected = released = 0;
+    multicore_launch_core1(core1_main);
+}
+
+void audio_worker_set_pipeline(const dsp_pipeline_t *p, const audio_vad_t *g) {
+    pipeline = p;
+    gate = g;
+}
+
+uint16_t *audio_worker_slot(void) {
+    if (submitted - released >= AUDIO_WORKER_SLOTS) return NULL;
+    return raw[submitted % AUDIO_WORKER_SLOTS];
+}
+
+void audio_worker_submit(void) {
+    multicore_fifo_push_blocking(submitted % AUDIO_WORKER_SLOTS);
+    submitted++;
+}
+
+bool audio_worker_collect(const uint8_t **out) {
+    if (collected == submitted || !multicore_fifo_rvalid()) return false;
+    uint32_t word = multicore_fifo_pop_blocking();
+    uint32_t slot = word & 0xff;
+    *out = word & WORKER_ACTIVE ? packed[slot] : NULL;
+    collected++;
+    return true;
+}
+
+void audio_worker_release(void) {
+    released = collected;
+}
+
+uint32_t audio_worker_in_flight(void) {
+    return submitted - collected;
+}
+
+void audio_worker_flush(void) {
+    while (collected != submitted) {
+        multicore_fifo_pop_blocking();
+        collected++;
+    }
+    released = collected;
+}
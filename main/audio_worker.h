@@ -0,0 +1,33 @@
+#ifndef AUDIO_WORKER_H
+#define AUDIO_WORKER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "audio_capture.h"
+#include "audio_format.h"
+#include "audio_dsp.h"
+#include "audio_vad.h"
+
+// Blocos em voo entre os núcleos (a FIFO do SIO tem 8 posições)
+#define AUDIO_WORKER_SLOTS 4
+
+// Condicionamento e codificação dos blocos no núcleo 1. O núcleo 0 põe
+// blocos crus num slot e recebe, na mesma ordem, o bloco codificado e a
+// decisão do VAD. Os dois lados só trocam índices pela FIFO entre os
+// núcleos; o núcleo 1 não chama o FreeRTOS.
+void audio_worker_start(audio_format_t fmt);
+// Chamar com nada em voo
+void audio_worker_set_pipeline(const dsp_pipeline_t *p, const audio_vad_t *gate);
+// Slot livre para AUDIO_BLOCK_SAMPLES amostras cruas, ou NULL se todos em voo
+uint16_t *audio_worker_slot(void);
+void audio_worker_submit(void);
+// Próximo bloco pronto: bytes codificados (NULL se o gate o descartou)
+bool audio_worker_collect(const uint8_t **packed);
+// Devolve o slot do último collect
+void audio_worker_release(void);
+uint32_t audio_worker_in_flight(void);
+// Espera e descarta tudo que está em voo
+void audio_worker_flush(void);
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef CYCLE_COUNT_H
+#define CYCLE_COUNT_H
+
+#include <stdint.h>
+#include "hardware/structs/systick.h"
+
+// Contagem de ciclos de CPU pelo SysTick, para os benchmarks do boot. O
+// tick do FreeRTOS está num alarme do timer, então o SysTick fica livre.
+#define CYCLE_COUNT_MASK 0x00ffffff
+
+// Clock do processador, contando para baixo em 24 bits
+static inline void cycle_count_start(void) {
+    systick_hw->rvr = CYCLE_COUNT_MASK;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5;
+}
+
+static inline uint32_t cycle_count_now(void) {
+    return systick_hw->cvr;
+}
+
+// Ciclos entre duas leituras; janelas de até 2^24 ciclos (~134 ms a 125 MHz)
+static inline uint32_t cycle_count_elapsed(uint32_t start, uint32_t end) {
+    return (start - end) & CYCLE_COUNT_MASK;
+}
+
+#endif
@@ -0,0 +1,138 @@
+#include "hcsr04.h"
+
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/pio.h"
+#include "hardware/pio_instructions.h"
+#include "hardware/sync.h"
+
+#include "hcsr04.pio.h"
+#include "sonar.h"
+
+#define HCSR04_RING_BITS 6   // HCSR04_RING_LEN * 4 bytes
+// Sem modo contínuo no DMA do RP2040: 2^32 leituras são anos de medição
+#define HCSR04_DMA_COUNT 0xffffffffu
+// Cada contagem da pausa extra são 32 ciclos de PIO
+#define HCSR04_HOLDOFF_CYCLES 32
+// Pausa mínima fixa no programa depois do eco (19 << 16 em hcsr04.pio)
+#define HCSR04_GAP_CYCLES (19u << 16)
+// Passo do eco: 2 ciclos (jmp pin + jmp x--)
+#define HCSR04_STEP_CYCLES 2
+
+_Static_assert(HCSR04_RING_LEN * sizeof(uint32_t) == (1u << HCSR04_RING_BITS),
+               "anel do DMA precisa ter 2^HCSR04_RING_BITS bytes");
+
+static uint32_t ring[HCSR04_RING_LEN] __aligned(HCSR04_RING_LEN * sizeof(uint32_t));
+
+static PIO pio = pio0;
+static int sm = -1;
+static uint offset;
+static int dma_ch = -1;
+static hcsr04_cb_t done_cb = NULL;
+static float cm_per_step;
+static uint32_t cycles_per_us;
+static uint32_t gap_us;
+static volatile uint32_t period_us = SONAR_MIN_PERIOD_US;
+static uint64_t last_trigger_us;
+static uint64_t reading_trigger_us;  // trigger da última leitura empurrada
+
+// Leitura empurrada: a pausa mínima já corre no PIO. Como no sonar por
+// IRQ, o próximo trigger sai um período depois do anterior, mas nunca
+// antes da pausa mínima depois do eco.
+static void pio_irq(void) {
+    pio_interrupt_clear(pio, sm);
+    uint64_t now = time_us_64();
+    uint64_t next = last_trigger_us + period_us;
+    if (next < now + gap_us) next = now + gap_us;
+    uint32_t holdoff = (uint64_t)(next - now - gap_us) * cycles_per_us / HCSR04_HOLDOFF_CYCLES;
+    // Lido no fim da pausa mínima; FIFO cheio = CPU atrasada, fica a anterior
+    if (!pio_sm_is_tx_fifo_full(pio, sm)) pio_sm_put(pio, sm, holdoff);
+    reading_trigger_us = last_trigger_us;
+    last_trigger_us = next;
+    if (done_cb) done_cb();
+}
+
+void hcsr04_init(uint trig_pin, uint echo_pin, hcsr04_cb_t cb) {
+    done_cb = cb;
+    sm = pio_claim_unused_sm(pio, true);
+    offset = pio_add_program(pio, &hcsr04_program);
+    hcsr04_program_init(pio, sm, offset, trig_pin, echo_pin);
+
+    dma_ch = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(dma_ch);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_ring(&c, true, HCSR04_RING_BITS);
+    channel_config_set_dreq(&c, pio_get_dreq(pio, sm, false));
+    dma_channel_configure(dma_ch, &c, ring, &pio->rxf[sm], HCSR04_DMA_COUNT, false);
+
+    // A flag 0 relativa do programa é a flag de número sm
+    pio_set_irq0_source_enabled(pio, (pio_interrupt_source_t)(pis_interrupt0 + sm), true);
+    irq_add_shared_handler(PIO0_IRQ_0, pio_irq, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(PIO0_IRQ_0, true);
+}
+
+void hcsr04_set_interval_ms(uint32_t ms) {
+    uint32_t us = ms * 1000;
+    period_us = us < SONAR_MIN_PERIOD_US ? SONAR_MIN_PERIOD_US : us;
+}
+
+void hcsr04_start(uint32_t interval_ms) {
+    // 340 m/s ida e volta: 0,017015 cm por us de eco
+    cm_per_step = HCSR04_STEP_CYCLES * 1e6f / clock_get_hz(clk_sys) * 0.017015f;
+    cycles_per_us = clock_get_hz(clk_sys) / 1000000;
+    gap_us = HCSR04_GAP_CYCLES / cycles_per_us;
+    hcsr04_set_interval_ms(interval_ms);
+
+    pio_sm_set_enabled(pio, sm, false);
+    pio_sm_clear_fifos(pio, sm);
+    pio_sm_restart(pio, sm);
+    // Parado no meio de um ciclo: baixa o trigger e volta ao início
+    pio_sm_exec(pio, sm, pio_encode_set(pio_pins, 0));
+    pio_sm_exec(pio, sm, pio_encode_jmp(offset));
+    pio_interrupt_clear(pio, sm);
+    dma_channel_transfer_to_buffer_now(dma_ch, ring, HCSR04_DMA_COUNT);
+
+    // O primeiro pull acha pausa extra zero: o primeiro trigger sai já
+    pio_sm_put(pio, sm, 0);
+    last_trigger_us = time_us_64();
+    reading_trigger_us = 0;
+    pio_sm_set_enabled(pio, sm, true);
+}
+
+void hcsr04_stop(void) {
+    pio_sm_set_enabled(pio, sm, false);
+    dma_channel_abort(dma_ch);
+}
+
+uint32_t hcsr04_count(void) {
+    return HCSR04_DMA_COUNT - dma_channel_hw_addr(dma_ch)->transfer_count;
+}
+
+bool hcsr04_latest(uint32_t *steps) {
+    uint32_t n = hcsr04_count();
+    if (n == 0) return false;
+    *steps = ring[(n - 1) % HCSR04_RING_LEN];
+    return true;
+}
+
+float hcsr04_steps_to_cm(uint32_t steps) {
+    return steps * cm_per_step;
+}
+
+float hcsr04_latest_cm(void) {
+    uint32_t steps;
+    if (!hcsr04_latest(&steps) || steps == HCSR04_NO_ECHO) return -1.0f;
+    float cm = hcsr04_steps_to_cm(steps);
+    return cm < HCSR04_MAX_CM ? cm : -1.0f;
+}
+
+uint64_t hcsr04_latest_trigger_us(void) {
+    // 64 bits não são atômicos no M0+: lê com a IRQ do PIO parada
+    uint32_t irq = save_and_disable_interrupts();
+    uint64_t t = reading_trigger_us;
+    restore_interrupts(irq);
+    return t;
+}
@@ -0,0 +1,42 @@
+#ifndef HCSR04_H
+#define HCSR04_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+
+// Leituras guardadas no anel de DMA (potência de 2)
+#define HCSR04_RING_LEN 16
+// Ecos mais longos que isso são "sem objeto" (o sensor expira em ~38 ms)
+#define HCSR04_MAX_CM 400.0f
+
+// Chamado na IRQ do PIO a cada leitura empurrada
+typedef void (*hcsr04_cb_t)(void);
+
+// Motor de medição autônomo: um state machine de PIO gera o trigger e
+// mede o eco em ciclos de clock; o DMA copia cada leitura do RX FIFO para
+// um anel em RAM. Depois do start a CPU só lê o anel e, numa IRQ curta
+// por leitura, completa a pausa até o próximo trigger.
+void hcsr04_init(uint trig_pin, uint echo_pin, hcsr04_cb_t cb);
+// Período entre triggers, como em sonar_set_period_ms: mínimo de 25 ms e
+// sempre ~10 ms de silêncio depois do eco, então ecos longos esticam o
+// ciclo. Pode ser trocado com o motor rodando; vale a partir do próximo eco.
+void hcsr04_set_interval_ms(uint32_t ms);
+void hcsr04_start(uint32_t interval_ms);
+void hcsr04_stop(void);
+// Leituras gravadas desde o start; mudou = há leitura nova
+uint32_t hcsr04_count(void);
+// Passos de uma leitura em que o eco não subiu (sensor ausente)
+#define HCSR04_NO_ECHO 0xffffffffu
+
+// Última leitura em passos de 2 ciclos (HCSR04_NO_ECHO se o eco não
+// subiu); false se ainda não houve nenhuma
+bool hcsr04_latest(uint32_t *steps);
+float hcsr04_steps_to_cm(uint32_t steps);
+// Última distância em cm, ou -1 se não houver leitura ou eco válido
+float hcsr04_latest_cm(void);
+// Hora do trigger (µs desde o boot) da última leitura, pela agenda que a
+// IRQ do PIO mantém; 0 antes da primeira
+uint64_t hcsr04_latest_trigger_us(void);
+
+#endif
@@ -0,0 +1,118 @@
+#include "hrtimer.h"
+
+#include "hardware/sync.h"
+
+#include "queue.h"
+#include "task.h"
+
+// Disparos HRTIMER_TASK esperando a tarefa
+#define HRTIMER_FILA 8
+#define HRTIMER_STACK 256
+
+static QueueHandle_t fila;
+
+static void dispatch(hrtimer_t *t) {
+    if (t->dispatch == HRTIMER_ISR) {
+        t->cb(t);
+        return;
+    }
+    BaseType_t woken = pdFALSE;
+    if (!fila || xQueueSendFromISR(fila, &t, &woken) != pdTRUE) t->overruns++;
+    portYIELD_FROM_ISR(woken);
+}
+
+static int64_t alarm_cb(alarm_id_t id, void *user) {
+    (void)id;
+    hrtimer_t *t = user;
+    uint32_t gen = t->gen;
+    if (!t->active) return 0;
+
+    uint32_t late = time_us_64() - t->deadline_us;
+    if (late > t->late_us_max) t->late_us_max = late;
+    t->fired++;
+    dispatch(t);
+
+    // O callback parou ou rearmou o timer: este alarme acaba aqui
+    if (!t->active || t->gen != gen) return 0;
+    if (!t->auto_reload) {
+        t->active = false;
+        t->alarm = 0;
+        return 0;
+    }
+    t->deadline_us += t->period_us;
+    // Negativo: relativo ao prazo anterior, não à hora da IRQ
+    return -(int64_t)t->period_us;
+}
+
+static void service_task(void *p) {
+    (void)p;
+    while (true) {
+        hrtimer_t *t;
+        if (xQueueReceive(fila, &t, portMAX_DELAY) == pdTRUE) t->cb(t);
+    }
+}
+
+void hrtimer_service_init(UBaseType_t prio) {
+    fila = xQueueCreate(HRTIMER_FILA, sizeof(hrtimer_t *));
+    xTaskCreate(service_task, "HRTimer", HRTIMER_STACK, NULL, prio, NULL);
+}
+
+void hrtimer_init(hrtimer_t *t, const char *name, uint32_t period_us, bool auto_reload,
+                  void *id, hrtimer_cb_t cb, hrtimer_dispatch_t dispatch) {
+    t->name = name;
+    t->period_us = period_us;
+    t->auto_reload = auto_reload;
+    t->dispatch = dispatch;
+    t->cb = cb;
+    t->id = id;
+    t->active = false;
+    t->gen = 0;
+    t->alarm = 0;
+    t->deadline_us = 0;
+    t->fired = 0;
+    t->late_us_max = 0;
+    t->overruns = 0;
+}
+
+static void disarm(hrtimer_t *t) {
+    t->gen++;
+    t->active = false;
+    if (t->alarm > 0) alarm_pool_cancel_alarm(alarm_pool_get_default(), t->alarm);
+    t->alarm = 0;
+}
+
+void hrtimer_start_at(hrtimer_t *t, uint64_t at_us) {
+    uint32_t irq = save_and_disable_interrupts();
+    disarm(t);
+    t->active = true;
+    t->deadline_us = at_us;
+    // Prazo já passado dispara na hora; um one-shot pode até acabar
+    // dentro da chamada, e aí não fica alarme para cancelar
+    alarm_id_t a = alarm_pool_add_alarm_at(alarm_pool_get_default(),
+                                           from_us_since_boot(at_us), alarm_cb, t, true);
+    if (t->active) t->alarm = a;
+    restore_interrupts(irq);
+}
+
+void hrtimer_start(hrtimer_t *t) {
+    hrtimer_start_at(t, time_us_64() + t->period_us);
+}
+
+void hrtimer_stop(hrtimer_t *t) {
+    uint32_t irq = save_and_disable_interrupts();
+    disarm(t);
+    restore_interrupts(irq);
+}
+
+void hrtimer_change_period(hrtimer_t *t, uint32_t period_us) {
+    t->period_us = period_us;
+    hrtimer_start(t);
+}
+
+bool hrtimer_is_active(const hrtimer_t *t) {
+    return t->active;
+}
+
+void *hrtimer_get_id(const hrtimer_t *t) {
+    return t->id;
+}
@@ -0,0 +1,58 @@
+#ifndef HRTIMER_H
+#define HRTIMER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+
+#include "FreeRTOS.h"
+
+typedef struct hrtimer hrtimer_t;
+typedef void (*hrtimer_cb_t)(hrtimer_t *t);
+
+typedef enum {
+    HRTIMER_ISR,   // callback na IRQ do alarme: curto, só APIs FromISR
+    HRTIMER_TASK,  // callback na tarefa do serviço, como no daemon de timers
+} hrtimer_dispatch_t;
+
+// Timer de software com prazo em µs sobre o alarm pool padrão do SDK, ao
+// lado dos timers do FreeRTOS (que andam em ticks de 10 ms). Mesmo
+// modelo de xTimerCreate/xTimerStart: período, auto-reload, id e um
+// callback que recebe o timer; a struct é do chamador.
+struct hrtimer {
+    const char *name;
+    uint32_t period_us;
+    bool auto_reload;
+    hrtimer_dispatch_t dispatch;
+    hrtimer_cb_t cb;
+    void *id;
+
+    volatile bool active;
+    volatile uint32_t gen;   // muda a cada start/stop: descarta alarme velho
+    alarm_id_t alarm;
+    uint64_t deadline_us;    // próximo disparo
+
+    // Instrumentação
+    uint32_t fired;
+    uint32_t late_us_max;    // atraso máximo da IRQ sobre o prazo
+    uint32_t overruns;       // disparos HRTIMER_TASK perdidos com a fila cheia
+};
+
+// Fila e tarefa dos callbacks HRTIMER_TASK; chamar antes do escalonador
+void hrtimer_service_init(UBaseType_t prio);
+// Como xTimerCreate; não arma
+void hrtimer_init(hrtimer_t *t, const char *name, uint32_t period_us, bool auto_reload,
+                  void *id, hrtimer_cb_t cb, hrtimer_dispatch_t dispatch);
+// Como xTimerStart/xTimerReset: dispara period_us a partir de agora.
+// Periódicos seguem em prazos absolutos, sem acumular atraso.
+// Estas chamadas valem em tarefa, em IRQ e dentro do próprio callback.
+void hrtimer_start(hrtimer_t *t);
+// Primeiro disparo num instante absoluto (µs desde o boot)
+void hrtimer_start_at(hrtimer_t *t, uint64_t at_us);
+void hrtimer_stop(hrtimer_t *t);
+// Como xTimerChangePeriod: troca o período e rearma a partir de agora
+void hrtimer_change_period(hrtimer_t *t, uint32_t period_us);
+bool hrtimer_is_active(const hrtimer_t *t);
+void *hrtimer_get_id(const hrtimer_t *t);
+
+#endif
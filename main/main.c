@@ -5,161 +5,471 @@
 #include "hardware/adc.h"
 #include "hardware/irq.h"
 
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "stream_buffer.h"
+
+#include "audio_capture.h"
+#include "audio_play.h"
+#include "audio_format.h"
+#include "audio_recorder.h"
+#include "audio_bench.h"
+#include "hcsr04.h"
+#include "sonar.h"
+#include "sonar_array.h"
+#include "range_filter.h"
+#include "ping_sched.h"
+#include "servo_out.h"
+#include "servo_motion.h"
+#include "radar.h"
+#include "hrtimer.h"
+#include "rtos_tick.h"
+#include "rtos_delay.h"
+#include "ranging.h"
+#include "audio_task.h"
+#include "scan_task.h"
+#include "telem.h"
+
 #define SERVO_PIN 15
 #define ECHO_PIN 6
 #define TRIG_PIN 7
 #define AUDIO_IN_PIN 27
 #define AUDIO_OUT_PIN 28
 #define LED_BLOCK_PIN 14  // LED acende quando em bloqueio
+// Varredura do servo: velocidade e aceleração do perfil trapezoidal
+#define SERVO_VEL_DEG_S 60
+#define SERVO_ACC_DEG_S2 240
+// O servo sai de uma posição desconhecida no boot: a varredura só começa
+// depois que ele chega em 0
+#define SERVO_ASSENTA_MS 1000
+// Varredura foveada: depois de cada passada completa, SCAN_PASSADAS
+// idas e voltas só nos setores com eco até SONAR_WATCH_MM nos últimos
+// SCAN_MARCA_MS (mais que uma passada completa); 0 = varredura uniforme
+#define SCAN_PASSADAS 8
+#define SCAN_MARCA_MS 4000
+// Radar: cada ping do sensor 0 vai para a grade polar com o ângulo do
+// servo no trigger e os quadros saem pela USB no lugar das distâncias
+#define MODO_RADAR 1
+// Mede no boot o custo do pulso em float contra o de ponto fixo
+#define SERVO_BENCH 1
+// Mede no boot os ciclos por amostra dos codecs e do decimador
+#define AUDIO_BENCH 1
+// Mede na partida o tempo de CPU que a idle recupera com rtos_delay no
+// lugar das esperas girando
+#define DELAY_BENCH 1
+
+// Backend de ranging
+#define SONAR_PIO 0      // um sensor, medido pelo PIO + DMA
+#define SONAR_IRQ 1      // um sensor, por IRQ de GPIO e alarme
+#define SONAR_ARRAY 2    // vários sensores em grupos intercalados
+#define SONAR_BACKEND SONAR_PIO
+// Grupos do array: vizinhos na tabela nunca disparam juntos
+#define SONAR_GRUPOS 2
+// Intervalo entre pings adaptativo: rápido com alvo perto ou chegando,
+// lento com a cena parada além de SONAR_WATCH_MM
+#define SONAR_MIN_MS 25
+#define SONAR_MAX_MS 250
+#define SONAR_WATCH_MM 1000
+// Histerese do bloqueio: entra abaixo de 10 cm, sai acima de 12 cm
+#define BLOQUEIO_ENTRA_MM 100
+#define BLOQUEIO_SAI_MM 120
 
 #define SAMPLE_RATE 8000
-#define RECORD_TIME_SECONDS 3
-#define AUDIO_SAMPLES (SAMPLE_RATE * RECORD_TIME_SECONDS)
-
-char audio[AUDIO_SAMPLES];
-int wav_position = 0;
-
-// === Ultrassônico globals ===
-volatile bool echo_got = false;
-volatile uint32_t start_us = 0;
-volatile uint32_t end_us = 0;
-bool bloqueado = false;
-
-// === PWM Servo Setup ===
-void setup_servo_pwm(uint pin) {
-    gpio_set_function(pin, GPIO_FUNC_PWM);
-    uint slice = pwm_gpio_to_slice_num(pin);
-
-    pwm_config config = pwm_get_default_config();
-    pwm_config_set_clkdiv(&config, 64.f);
-    pwm_config_set_wrap(&config, 39062); // 50Hz
-    pwm_init(slice, &config, true);
-}
-
-void set_servo_angle(uint pin, float angle_deg) {
-    float pulse_ms = 1.0f + (angle_deg / 180.0f); // 1ms a 2ms
-    uint16_t level = (uint16_t)(pulse_ms * 1953.1f);
-    pwm_set_gpio_level(pin, level);
-}
-
-// === Ultrassônico ===
-void gpio_callback(uint gpio, uint32_t events) {
-    if (gpio == ECHO_PIN) {
-        if (gpio_get(ECHO_PIN)) {
-            start_us = time_us_32();
-            echo_got = false;
-        } else {
-            end_us = time_us_32();
-            echo_got = true;
-        }
-    }
+// Janela congelada no trigger: PRE antes da detecção, POST depois. Em
+// ADPCM, 9 s cabem em ~37 KB, a RAM que 3 s de 12 bits empacotados
+// ocupavam: 3x mais gravação.
+#define PRE_TRIGGER_MS 3000
+#define POST_TRIGGER_MS 6000
+// Fonte do trigger de gravação
+#define TRIGGER_MODO AUDIO_TRIGGER_QUALQUER
+// Blocos em silêncio não entram no anel
+#define GATE_SILENCIO 1
+// IMA-ADPCM: 4 bits por amostra mais 4 B de cabeçalho por bloco.
+// AUDIO_FMT_PACKED12 guarda a resolução total com 50% a mais que 8 bits.
+#define AUDIO_FORMAT AUDIO_FMT_ADPCM
+// O anel guarda blocos inteiros, cada um codificado de forma independente.
+// Arredonda como audio_recorder_arm: PRE e POST em blocos, cada um para
+// cima, senão o pré-trigger perde blocos em toda gravação.
+#define AUDIO_MS_BLOCKS(ms) \
+    (((ms) * SAMPLE_RATE / 1000 + AUDIO_BLOCK_SAMPLES - 1) / AUDIO_BLOCK_SAMPLES)
+#define AUDIO_RING_BLOCKS (AUDIO_MS_BLOCKS(PRE_TRIGGER_MS) + AUDIO_MS_BLOCKS(POST_TRIGGER_MS))
+#define AUDIO_BYTES (AUDIO_RING_BLOCKS * AUDIO_FORMAT_BYTES(AUDIO_FORMAT, AUDIO_BLOCK_SAMPLES))
+// Folga de 8 blocos (256 ms) para a tarefa de áudio drenar o stream
+#define AUDIO_STREAM_SIZE (8 * AUDIO_BLOCK_BYTES)
+#define AUDIO_ESPERA_MS 20
+
+// Prioridades pela latência exigida: o LED reage ao objeto em ms; o
+// áudio tem 256 ms de folga no stream; o servo se move sozinho pelo
+// timer e a tarefa só escolhe alvos; a telemetria pode atrasar. Os
+// callbacks adiados dos timers de µs rodam junto com o ranging.
+#define PRIO_HRTIMER 4
+#define PRIO_RANGING 4
+#define PRIO_AUDIO 3
+#define PRIO_SCAN 2
+#define PRIO_TELEM 1
+#define TELEM_FILA 16
+#define TELEM_ESPERA_MS 50
+// Fração do tempo na tarefa idle, pelos run-time stats
+#define TELEM_CARGA_MS 5000
+#define PINGS_FILA 8
+
+_Static_assert(AUDIO_BLOCK_SAMPLES % AUDIO_FORMAT_FRAME == 0,
+               "blocos de captura devem alinhar com os quadros do codec");
+
+uint8_t audio[AUDIO_BYTES];
+StreamBufferHandle_t xStreamAudio;
+QueueHandle_t xFilaTelem;
+QueueHandle_t xFilaPings;
+TaskHandle_t xRanging;
+TaskHandle_t xAudio;
+
+#if SONAR_BACKEND == SONAR_ARRAY
+// Na ordem física; o primeiro usa os pinos do sensor único
+static const sonar_pins_t sonares[] = {
+    {TRIG_PIN, ECHO_PIN},
+    {9, 8},
+    {11, 10},
+    {13, 12},
+};
+#define N_SONARES (sizeof(sonares) / sizeof(sonares[0]))
+#else
+#define N_SONARES 1
+#endif
+_Static_assert(N_SONARES <= RANGING_MAX_SONARES, "sonares demais para a tarefa de ranging");
+
+// === Servo ===
+// Pulsos medidos do servo usado; SERVO_CAL_DEFAULT é o 1-2 ms nominal
+static const servo_cal_t servo_cal = SERVO_CAL(1000, 2000);
+servo_motion_t servo;
+
+// === Sonar ===
+// Leitura nova do sensor i; dist em cm, -1 sem eco válido; trigger_us
+// é a hora do ping
+bool ler_sonar(uint32_t i, float *dist, uint64_t *trigger_us) {
+#if SONAR_BACKEND == SONAR_PIO
+    // O PIO mede sozinho; só há leitura nova se o contador andou
+    static uint32_t leituras = 0;
+    uint32_t n = hcsr04_count();
+    if (n == leituras) return false;
+    leituras = n;
+    *dist = hcsr04_latest_cm();
+    *trigger_us = hcsr04_latest_trigger_us();
+    return true;
+#else
+    // O sonar re-dispara sozinho ao fim de cada eco
+    sonar_reading_t r;
+#if SONAR_BACKEND == SONAR_IRQ
+    if (!sonar_poll(&r)) return false;
+#else
+    if (!sonar_array_poll(i, &r)) return false;
+#endif
+    *dist = r.ok ? sonar_echo_to_cm(r.echo_us) : -1.0f;
+    *trigger_us = r.trigger_us;
+    return true;
+#endif
 }
 
-void send_trig_pulse() {
-    gpio_put(TRIG_PIN, 1);
-    sleep_us(10);
-    gpio_put(TRIG_PIN, 0);
+void sonar_set_period(uint32_t ms) {
+#if SONAR_BACKEND == SONAR_PIO
+    hcsr04_set_interval_ms(ms);
+#elif SONAR_BACKEND == SONAR_IRQ
+    sonar_set_period_ms(ms);
+#else
+    sonar_array_set_period_ms(ms);
+#endif
 }
 
-float medir_distancia_cm() {
-    send_trig_pulse();
-    sleep_ms(100);
-    if (echo_got && end_us > start_us) {
-        uint32_t delta_t = end_us - start_us;
-        echo_got = false;
-        return delta_t * 0.017015f;
-    }
-    return -1.0f;
+// === Telemetria ===
+#if DELAY_BENCH
+// Menor prioridade: a espera girando só tira tempo da idle
+static void delay_bench(void) {
+    rtos_delay_bench_t b;
+    rtos_delay_bench(&b);
+    printf("Esperas: ociosa %lu.%lu%% girando (%lu us), %lu.%lu%% bloqueando (%lu us)\n",
+           (unsigned long)(b.spin_idle_permille / 10), (unsigned long)(b.spin_idle_permille % 10),
+           (unsigned long)b.spin_us,
+           (unsigned long)(b.block_idle_permille / 10), (unsigned long)(b.block_idle_permille % 10),
+           (unsigned long)b.block_us);
 }
+#endif
 
-// === Gravação e Reprodução ===
-void adc_record_audio() {
-    adc_select_input(AUDIO_IN_PIN - 26);
-    for (int i = 0; i < AUDIO_SAMPLES; i++) {
-        uint16_t sample = adc_read();
-        audio[i] = sample >> 4; // Escala para 8 bits
-        sleep_us(1000000 / SAMPLE_RATE);
-    }
+// Fração do tempo na tarefa idle, pelos run-time stats
+static rtos_idle_window_t janela_carga;
+
+void telem_iniciar(void) {
+#if DELAY_BENCH
+    delay_bench();
+#endif
+    rtos_idle_begin(&janela_carga);
 }
 
-void pwm_play_audio() {
-    gpio_set_function(AUDIO_OUT_PIN, GPIO_FUNC_PWM);
-    uint slice = pwm_gpio_to_slice_num(AUDIO_OUT_PIN);
+void telem_saida(const char *linha) {
+    fputs(linha, stdout);
+}
 
-    pwm_config config = pwm_get_default_config();
-    pwm_config_set_wrap(&config, 255); // 8-bit sample
-    pwm_config_set_clkdiv(&config, 1.0f);
-    pwm_init(slice, &config, true);
-    pwm_set_enabled(slice, true);
+void telem_carga(telem_carga_t *c) {
+    rtos_tick_stats_t st;
+    rtos_tick_stats(&st);
+    c->ociosa_permille = rtos_idle_permille(&janela_carga);
+    c->sonos = st.sleeps;
+    c->ticks_pulados = st.ticks_skipped;
+}
 
-    for (int i = 0; i < AUDIO_SAMPLES; i++) {
-        pwm_set_gpio_level(AUDIO_OUT_PIN, audio[i]);
-        sleep_us(1000000 / SAMPLE_RATE);
+#if MODO_RADAR
+// Quadro pronto do radar vai pela USB e volta para o escritor
+void radar_enviar(void) {
+    const radar_frame_t *f = radar_wait(0);
+    if (f) {
+        radar_stream(f);
+        radar_release();
     }
+}
+#endif
+
+static const telem_io_t telem_io = {
+    .iniciar = telem_iniciar,
+    .saida = telem_saida,
+    .carga = telem_carga,
+#if MODO_RADAR
+    .volta = radar_enviar,
+#else
+    .volta = NULL,
+#endif
+};
+
+telem_t telem = {
+    .io = &telem_io,
+    .espera_ms = TELEM_ESPERA_MS,
+    .carga_ms = TELEM_CARGA_MS,
+};
+
+// === Ranging ===
+// Fim de medição na IRQ do sonar: acorda a tarefa na hora
+void sonar_pronto(const sonar_reading_t *r) {
+    BaseType_t acordou = pdFALSE;
+    vTaskNotifyGiveFromISR(xRanging, &acordou);
+    portYIELD_FROM_ISR(acordou);
+}
+
+void sonar_array_pronto(uint idx, const sonar_reading_t *r) {
+    sonar_pronto(r);
+}
+
+void hcsr04_pronto(void) {
+    sonar_pronto(NULL);
+}
+
+// Setup ultrassônico. Roda dentro da tarefa de ranging: o primeiro
+// callback de fim de medição já encontra xRanging criado.
+void sonar_iniciar(void) {
+#if SONAR_BACKEND == SONAR_PIO
+    hcsr04_init(TRIG_PIN, ECHO_PIN, hcsr04_pronto);
+    hcsr04_start(SONAR_MAX_MS);
+#elif SONAR_BACKEND == SONAR_IRQ
+    sonar_init(TRIG_PIN, ECHO_PIN, sonar_pronto);
+    sonar_set_period_ms(SONAR_MAX_MS);
+    sonar_start_continuous();
+#else
+    sonar_array_init(sonares, N_SONARES, SONAR_GRUPOS, sonar_array_pronto);
+    sonar_array_set_period_ms(SONAR_MAX_MS);
+    sonar_array_start();
+#endif
+}
+
+void led_bloqueio(bool on) {
+    gpio_put(LED_BLOCK_PIN, on);
+}
+
+int32_t servo_mdeg_at(uint64_t us) {
+    return servo_motion_mdeg_at(&servo, us);
+}
 
-    pwm_set_enabled(slice, false);
+void telem_bloqueio(uint32_t i, const ping_sched_t *s) {
+    telem_send(&telem, TELEM_BLOQUEIO, i, s->pings_per_s, s->latency_ms_last,
+               ping_sched_mean_latency_ms(s), s->latency_ms_max);
 }
 
-// === MAIN ===
+void telem_distancia(uint32_t i, int32_t mm, int32_t mdeg, const range_filter_t *f) {
+    telem_send(&telem, TELEM_DISTANCIA, i, mm, mdeg, range_filter_mm(f),
+               range_filter_closing_mm_s(f));
+}
+
+// O corpo da tarefa fica em ranging.c, sem SDK; aqui só os drivers
+static const ranging_io_t ranging_io = {
+    .iniciar = sonar_iniciar,
+    .ler = ler_sonar,
+    .set_period_ms = sonar_set_period,
+    .led = led_bloqueio,
+    .mdeg_at = servo_mdeg_at,
+    .agora_us = time_us_64,
+    .bloqueio = telem_bloqueio,
+#if MODO_RADAR
+    .distancia = NULL,
+#else
+    .distancia = telem_distancia,
+#endif
+};
+
+// É a tarefa de maior prioridade: o LED muda no mesmo ms em que o filtro
+// decide, qualquer que seja a carga de áudio
+ranging_t ranging = {
+    .io = &ranging_io,
+    .n_sonares = N_SONARES,
+    .entra_mm = BLOQUEIO_ENTRA_MM,
+    .sai_mm = BLOQUEIO_SAI_MM,
+    .min_ms = SONAR_MIN_MS,
+    .max_ms = SONAR_MAX_MS,
+    .watch_mm = SONAR_WATCH_MM,
+    .audio = &xAudio,
+};
+
+// === Varredura ===
+void servo_assentar(void) {
+    rtos_delay_ms(SERVO_ASSENTA_MS);
+}
+
+int32_t servo_mdeg(void) {
+    return servo_motion_mdeg(&servo);
+}
+
+bool servo_chegou(void) {
+    return servo_motion_done(&servo);
+}
+
+void servo_mover(int32_t mdeg) {
+    servo_motion_move_to(&servo, mdeg);
+}
+
+void servo_parar(void) {
+    servo_motion_halt(&servo);
+}
+
+uint32_t agora_ms(void) {
+    return to_ms_since_boot(get_absolute_time());
+}
+
+#if MODO_RADAR
+void radar_ping(const ping_t *p) {
+    radar_add(p->mdeg, p->mm);
+}
+#endif
+
+// O corpo da tarefa fica em scan_task.c, sem SDK; aqui só o servo e o
+// radar
+static const scan_io_t scan_io = {
+    .assentar = servo_assentar,
+    .mdeg = servo_mdeg,
+    .chegou = servo_chegou,
+    .mover = servo_mover,
+    .parar = servo_parar,
+    .agora_ms = agora_ms,
+#if MODO_RADAR
+    .ping = radar_ping,
+    .fim_passada = radar_end_sweep,
+#else
+    .ping = NULL,
+    .fim_passada = NULL,
+#endif
+};
+
+scan_task_t varredura = {
+    .io = &scan_io,
+    .ranging = &ranging,
+    .watch_mm = SONAR_WATCH_MM,
+    .marca_ms = SCAN_MARCA_MS,
+    .passadas = SCAN_PASSADAS,
+    .quadro_ms = SERVO_FRAME_US / 1000,
+};
+
+// === Áudio ===
+void telem_gravando(bool por_objeto, const audio_vad_t *vad) {
+    telem_send(&telem, TELEM_GRAVANDO, por_objeto, audio_vad_mean_cost_us(vad), vad->cost_us_max,
+               0, 0);
+}
+
+void telem_tocando(void) {
+    telem_send(&telem, TELEM_TOCANDO, 0, 0, 0, 0, 0);
+}
+
+// O corpo da tarefa fica em audio_task.c; aqui só o gravador
+static const audio_io_t audio_io = {
+    .set_pipeline = audio_recorder_set_pipeline,
+    .set_gate = audio_recorder_set_gate,
+    .arm = audio_recorder_arm,
+    .trigger = audio_recorder_trigger,
+    .state = audio_recorder_state,
+    .poll = audio_recorder_poll,
+    .play = audio_recorder_play,
+    .gravando = telem_gravando,
+    .tocando = telem_tocando,
+};
+
+audio_task_t gravacao = {
+    .io = &audio_io,
+    .modo = TRIGGER_MODO,
+    .gate = GATE_SILENCIO,
+    .pre_ms = PRE_TRIGGER_MS,
+    .post_ms = POST_TRIGGER_MS,
+    .espera_ms = AUDIO_ESPERA_MS,
+    .ranging = &ranging,
+};
+
 int main() {
     stdio_init_all();
     adc_init();
     adc_gpio_init(AUDIO_IN_PIN);
+    audio_capture_init(AUDIO_IN_PIN - 26, SAMPLE_RATE);
+    audio_capture_set_oversampling(true);
+    audio_play_init(AUDIO_OUT_PIN, SAMPLE_RATE);
+    audio_play_set_wrap(audio_format_pwm_wrap(AUDIO_FORMAT));
+    audio_play_set_upsampling(true);
 
     // LED de bloqueio
     gpio_init(LED_BLOCK_PIN);
     gpio_set_dir(LED_BLOCK_PIN, GPIO_OUT);
     gpio_put(LED_BLOCK_PIN, 0);
 
-    // Setup ultrassônico
-    gpio_init(ECHO_PIN);
-    gpio_set_dir(ECHO_PIN, GPIO_IN);
-    gpio_set_irq_enabled_with_callback(ECHO_PIN,
-        GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true, gpio_callback);
-    gpio_init(TRIG_PIN);
-    gpio_set_dir(TRIG_PIN, GPIO_OUT);
-    gpio_put(TRIG_PIN, 0);
+    // Timers de µs; o servo já avança num deles
+    hrtimer_service_init(PRIO_HRTIMER);
 
     // Setup servo
-    setup_servo_pwm(SERVO_PIN);
-    sleep_ms(1000);
-
-    int ang = 0;
-    int dir = 1;
-    bool ja_gravou = false;
-
-    while (true) {
-        float dist = medir_distancia_cm();
-        if (dist > 0) {
-            printf("Distância: %.2f cm\n", dist);
-        }
-
-        if (dist > 0 && dist < 10.0f) {
-            bloqueado = true;
-            gpio_put(LED_BLOCK_PIN, 1);
-        } else {
-            bloqueado = false;
-            gpio_put(LED_BLOCK_PIN, 0);
-            ja_gravou = false;
-        }
-
-        if (!bloqueado) {
-            set_servo_angle(SERVO_PIN, ang);
-            ang += 5 * dir;
-            if (ang >= 180) dir = -1;
-            else if (ang <= 0) dir = 1;
-        }
-
-        if (bloqueado && !ja_gravou) {
-            printf("Objeto detectado! Gravando...\n");
-            adc_record_audio();
-            printf("Reproduzindo...\n");
-            pwm_play_audio();
-            ja_gravou = true;
-        }
-
-        sleep_ms(20);
-    }
+    int pan = servo_out_add(SERVO_PIN, &servo_cal, 0);
+    servo_out_start();
+    servo_motion_init(&servo, pan, SERVO_VEL_DEG_S, SERVO_ACC_DEG_S2, 0);
+    servo_motion_start();
+#if SERVO_BENCH
+    uint32_t ciclos_float, ciclos_fixo;
+    servo_pulse_bench(&ciclos_float, &ciclos_fixo);
+    printf("Servo: %lu ciclos/chamada em float, %lu em ponto fixo\n",
+           (unsigned long)ciclos_float, (unsigned long)ciclos_fixo);
+#endif
+#if AUDIO_BENCH
+    audio_bench_codec_t codec;
+    audio_bench_codec(&codec);
+    printf("Codec: ADPCM %lu/%lu ciclos/amostra (cod/dec), µ-law %lu/%lu\n",
+           (unsigned long)codec.adpcm_encode, (unsigned long)codec.adpcm_decode,
+           (unsigned long)codec.ulaw_encode, (unsigned long)codec.ulaw_decode);
+    printf("Decimador: %lu ciclos por amostra de saída\n", (unsigned long)audio_bench_decim());
+#endif
 
-    return 0;
-}
\ No newline at end of file
+    xStreamAudio = xStreamBufferCreate(AUDIO_STREAM_SIZE, AUDIO_BLOCK_BYTES);
+    audio_recorder_init(AUDIO_FORMAT, audio, sizeof(audio), SAMPLE_RATE, xStreamAudio);
+
+    xFilaTelem = xQueueCreate(TELEM_FILA, sizeof(telem_msg_t));
+    telem.fila = xFilaTelem;
+    xFilaPings = xQueueCreate(PINGS_FILA, sizeof(ping_t));
+    ranging.pings = xFilaPings;
+    varredura.pings = xFilaPings;
+#if MODO_RADAR
+    radar_init();
+#endif
+    xTaskCreate(ranging_task, "Ranging", 512, &ranging, PRIO_RANGING, &xRanging);
+    xTaskCreate(audio_task, "Audio", 1024, &gravacao, PRIO_AUDIO, &xAudio);
+    xTaskCreate(scan_task, "Scan", 512, &varredura, PRIO_SCAN, NULL);
+    xTaskCreate(telem_task, "Telem", 512, &telem, PRIO_TELEM, NULL);
+    vTaskStartScheduler();
+
+    while (true)
+        ;
+}
@@ -0,0 +1,77 @@
+#include "ping_sched.h"
+
+// Pelo menos tantos pings antes de o alvo chegar ao limiar
+#define SCHED_PINGS_TO_THRESHOLD 4
+
+static uint32_t next_interval(const ping_sched_t *s, const range_filter_t *f) {
+    if (f->near) return s->min_ms;
+    int32_t mm = range_filter_mm(f);
+    if (mm < 0) return s->max_ms;
+
+    // Pela distância: min_ms no limiar, max_ms a partir de watch_mm
+    int32_t left = mm - f->enter_mm;
+    int32_t span = s->watch_mm - f->enter_mm;
+    uint32_t iv = s->max_ms;
+    if (left <= 0) iv = s->min_ms;
+    else if (left < span) iv = s->min_ms + (uint32_t)(s->max_ms - s->min_ms) * left / span;
+
+    // Pela velocidade: tempo até o limiar dividido em N pings
+    int32_t closing = range_filter_closing_mm_s(f);
+    if (closing > 0 && left > 0) {
+        uint32_t ttc_ms = (uint32_t)left * 1000 / closing;
+        uint32_t by_speed = ttc_ms / SCHED_PINGS_TO_THRESHOLD;
+        if (by_speed < iv) iv = by_speed;
+    }
+
+    if (iv < s->min_ms) iv = s->min_ms;
+    if (iv > s->max_ms) iv = s->max_ms;
+    return iv;
+}
+
+void ping_sched_init(ping_sched_t *s, uint16_t min_ms, uint16_t max_ms, uint16_t watch_mm) {
+    s->min_ms = min_ms;
+    s->max_ms = max_ms;
+    s->watch_mm = watch_mm;
+    s->interval_ms = max_ms;
+    s->pings = 0;
+    s->pings_per_s = 0;
+    s->detections = 0;
+    s->latency_ms_last = 0;
+    s->latency_ms_max = 0;
+    s->latency_ms_total = 0;
+    s->window_us = 0;
+    s->window_pings = 0;
+    s->clear_us = 0;
+    s->was_near = false;
+}
+
+uint32_t ping_sched_update(ping_sched_t *s, const range_filter_t *f, int32_t z_mm,
+                           uint64_t now_us) {
+    s->pings++;
+    s->window_pings++;
+    if (now_us - s->window_us >= 1000000) {
+        s->pings_per_s = s->window_pings;
+        s->window_pings = 0;
+        s->window_us = now_us;
+    }
+
+    // Latência: o objeto entrou em algum momento depois da última leitura
+    // bruta sem nada perto, então now - clear_us é o pior caso da reação
+    // (intervalo entre pings + atraso do filtro)
+    if (f->near && !s->was_near && s->clear_us) {
+        uint32_t lat = (now_us - s->clear_us) / 1000;
+        s->detections++;
+        s->latency_ms_last = lat;
+        s->latency_ms_total += lat;
+        if (lat > s->latency_ms_max) s->latency_ms_max = lat;
+    }
+    if (z_mm < 0 || z_mm >= f->enter_mm) s->clear_us = now_us;
+    s->was_near = f->near;
+
+    s->interval_ms = next_interval(s, f);
+    return s->interval_ms;
+}
+
+uint32_t ping_sched_mean_latency_ms(const ping_sched_t *s) {
+    return s->detections ? s->latency_ms_total / s->detections : 0;
+}
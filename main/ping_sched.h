@@ -0,0 +1,39 @@
+#ifndef PING_SCHED_H
+#define PING_SCHED_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "range_filter.h"
+
+// Escolhe o intervalo entre pings a partir do alvo filtrado: rápido com
+// objeto perto ou se aproximando, lento com a cena parada. Também mede a
+// taxa de pings e a latência de detecção.
+typedef struct {
+    uint16_t min_ms;
+    uint16_t max_ms;
+    uint16_t watch_mm;   // abaixo disso o intervalo encurta com a distância
+    uint32_t interval_ms;
+
+    // Instrumentação
+    uint32_t pings;
+    uint32_t pings_per_s;       // última janela de 1 s
+    uint32_t detections;
+    uint32_t latency_ms_last;   // da última leitura sem objeto até o bloqueio
+    uint32_t latency_ms_max;
+    uint32_t latency_ms_total;
+
+    uint64_t window_us;
+    uint32_t window_pings;
+    uint64_t clear_us;
+    bool was_near;
+} ping_sched_t;
+
+void ping_sched_init(ping_sched_t *s, uint16_t min_ms, uint16_t max_ms, uint16_t watch_mm);
+// Chamar a cada leitura (z_mm bruto, -1 sem eco), depois do filtro;
+// retorna o próximo intervalo
+uint32_t ping_sched_update(ping_sched_t *s, const range_filter_t *f, int32_t z_mm,
+                           uint64_t now_us);
+uint32_t ping_sched_mean_latency_ms(const ping_sched_t *s);
+
+#endif
@@ -0,0 +1,90 @@
+#include "radar.h"
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+
+#include "queue.h"
+
+static radar_frame_t frames[2];
+static uint8_t writing;             // índice do quadro sendo preenchido
+static volatile bool reader_busy;   // o consumidor ainda segura o outro
+static QueueHandle_t ready;
+static uint32_t seq;
+static uint32_t dropped;
+
+static void clear(radar_frame_t *f) {
+    memset(f->mm, 0, sizeof(f->mm));
+    f->pings = 0;
+    f->start_ms = to_ms_since_boot(get_absolute_time());
+}
+
+void radar_init(void) {
+    ready = xQueueCreate(1, sizeof(uint8_t));
+    writing = 0;
+    reader_busy = false;
+    clear(&frames[writing]);
+}
+
+void radar_add(int32_t mdeg, int32_t mm) {
+    if (mdeg < 0) return;
+    uint32_t bin = mdeg / RADAR_BIN_MDEG;
+    if (bin >= RADAR_BINS) bin = RADAR_BINS - 1;
+
+    radar_frame_t *f = &frames[writing];
+    uint16_t v = mm < 0 || mm >= RADAR_FREE ? RADAR_FREE : mm < 1 ? 1 : mm;
+    // Mais de um ping no bin: vale o obstáculo mais perto
+    if (f->mm[bin] == RADAR_UNSEEN || v < f->mm[bin]) f->mm[bin] = v;
+    f->pings++;
+}
+
+void radar_end_sweep(int8_t dir) {
+    radar_frame_t *f = &frames[writing];
+    if (!f->pings) {
+        clear(f);
+        return;
+    }
+    f->seq = seq++;
+    f->dir = dir;
+    f->end_ms = to_ms_since_boot(get_absolute_time());
+
+    if (reader_busy) {
+        dropped++;
+    } else {
+        reader_busy = true;
+        xQueueSend(ready, &writing, 0);
+        writing ^= 1;
+    }
+    clear(&frames[writing]);
+}
+
+const radar_frame_t *radar_wait(TickType_t timeout) {
+    uint8_t i;
+    if (xQueueReceive(ready, &i, timeout) != pdTRUE) return NULL;
+    return &frames[i];
+}
+
+void radar_release(void) {
+    reader_busy = false;
+}
+
+void radar_stream(const radar_frame_t *f) {
+    static const char hex[] = "0123456789abcdef";
+    static char line[32 + RADAR_BINS * 4];
+
+    int n = snprintf(line, sizeof(line), "R %lu %d %u ", (unsigned long)f->seq, f->dir,
+                     f->pings);
+    for (uint32_t b = 0; b < RADAR_BINS; b++) {
+        uint16_t v = f->mm[b];
+        line[n++] = hex[v >> 12];
+        line[n++] = hex[(v >> 8) & 0xf];
+        line[n++] = hex[(v >> 4) & 0xf];
+        line[n++] = hex[v & 0xf];
+    }
+    line[n] = '\0';
+    puts(line);
+}
+
+uint32_t radar_dropped(void) {
+    return dropped;
+}
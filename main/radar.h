@@ -0,0 +1,41 @@
+#ifndef RADAR_H
+#define RADAR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "FreeRTOS.h"
+
+// Bins de 2° cobrindo 0 a 180°
+#define RADAR_BINS 90
+#define RADAR_BIN_MDEG (180000 / RADAR_BINS)
+// Valores especiais de um bin; o resto é a distância em mm
+#define RADAR_UNSEEN 0        // nenhum ping caiu no bin
+#define RADAR_FREE 0xffff     // pingado, sem eco
+
+// Uma varredura: a menor distância vista em cada bin de ângulo
+typedef struct {
+    uint32_t seq;
+    uint32_t start_ms;
+    uint32_t end_ms;
+    int8_t dir;               // +1 subindo de 0 a 180°, -1 descendo
+    uint16_t pings;
+    uint16_t mm[RADAR_BINS];
+} radar_frame_t;
+
+// Grade polar em buffer duplo: uma varredura é escrita enquanto a
+// anterior fica com o consumidor. Os quadros prontos saem por uma fila.
+void radar_init(void);
+// Um ping com o ângulo do servo na hora do trigger; mm < 0 = sem eco
+void radar_add(int32_t mdeg, int32_t mm);
+// Fecha a varredura e publica; se o consumidor ainda segura o quadro
+// anterior, esta varredura é descartada. Varredura sem pings é ignorada.
+void radar_end_sweep(int8_t dir);
+// Próximo quadro publicado, ou NULL no timeout. Devolver com radar_release.
+const radar_frame_t *radar_wait(TickType_t timeout);
+void radar_release(void);
+// Uma linha por quadro: "R seq dir pings" e 4 dígitos hex por bin
+void radar_stream(const radar_frame_t *f);
+uint32_t radar_dropped(void);
+
+#endif
@@ -0,0 +1,156 @@
+#include "range_filter.h"
+
+// Ruído da medição: ~3 mm de desvio (Q4)
+#define RF_R (9 << 4)
+// Densidade espectral da aceleração do alvo, (mm/s²)²·s: mão ~2 m/s²
+#define RF_Q_ACC 4000000LL
+// Incerteza inicial da velocidade: 1 m/s (Q4)
+#define RF_P11_INIT (1000000 << 4)
+// Gate de inovação: 3 desvios
+#define RF_GATE2 9
+// Tantas rejeições seguidas = o alvo mudou de verdade, recomeça
+#define RF_MAX_REJECTS 3
+#define RF_MAX_MISSES 5
+// Passos maiores são tratados como recomeço
+#define RF_MAX_DT_MS 500
+
+static int32_t median(const range_filter_t *f) {
+    int32_t s[RANGE_MEDIAN_LEN];
+    uint8_t n = f->win_n;
+    // Ordenação por inserção: 5 elementos
+    for (uint8_t i = 0; i < n; i++) {
+        int32_t v = f->win[i];
+        uint8_t j = i;
+        while (j > 0 && s[j - 1] > v) {
+            s[j] = s[j - 1];
+            j--;
+        }
+        s[j] = v;
+    }
+    return s[n / 2];
+}
+
+static void restart(range_filter_t *f, int32_t z_mm) {
+    f->x = z_mm << 8;
+    f->v = 0;
+    f->p00 = RF_R;
+    f->p01 = 0;
+    f->p11 = RF_P11_INIT;
+    f->tracking = true;
+    f->rejects = 0;
+}
+
+static void predict(range_filter_t *f, int32_t dt_ms) {
+    int64_t dt = dt_ms;
+    f->x += (int32_t)((int64_t)f->v * dt / 1000);
+
+    // P = F P F' + Q, F = [1 dt; 0 1]; Q do modelo de aceleração branca
+    int64_t p00 = f->p00, p01 = f->p01, p11 = f->p11;
+    int64_t q00 = (RF_Q_ACC << 4) * dt * dt * dt / 3000000000LL;
+    int64_t q01 = (RF_Q_ACC << 4) * dt * dt / 2000000;
+    int64_t q11 = (RF_Q_ACC << 4) * dt / 1000;
+    p00 += dt * (2 * p01 + dt * p11 / 1000) / 1000 + q00;
+    p01 += dt * p11 / 1000 + q01;
+    p11 += q11;
+
+    if (p00 > INT32_MAX) p00 = INT32_MAX;
+    if (p01 > INT32_MAX) p01 = INT32_MAX;
+    if (p11 > INT32_MAX) p11 = INT32_MAX;
+    f->p00 = p00;
+    f->p01 = p01;
+    f->p11 = p11;
+}
+
+// false se a medição caiu fora do gate
+static bool correct(range_filter_t *f, int32_t z_mm) {
+    int64_t y = ((int64_t)z_mm << 8) - f->x;  // inovação, mm Q8
+    int64_t s = (int64_t)f->p00 + RF_R;       // Q4
+
+    // y² > G²·S, com y em Q8 e S em Q4
+    if ((y * y) >> 12 > RF_GATE2 * s) return false;
+
+    // Ganhos em Q16
+    int64_t k0 = ((int64_t)f->p00 << 16) / s;
+    int64_t k1 = ((int64_t)f->p01 << 16) / s;
+    f->x += (int32_t)((k0 * y) >> 16);
+    f->v += (int32_t)((k1 * y) >> 16);
+
+    int64_t p01 = f->p01;
+    f->p00 -= (int32_t)((k0 * f->p00) >> 16);
+    f->p01 -= (int32_t)((k0 * p01) >> 16);
+    f->p11 -= (int32_t)((k1 * p01) >> 16);
+    return true;
+}
+
+void range_filter_init(range_filter_t *f, uint16_t enter_mm, uint16_t exit_mm) {
+    f->win_n = 0;
+    f->win_pos = 0;
+    f->tracking = false;
+    f->misses = 0;
+    f->rejects = 0;
+    f->last_us = 0;
+    f->enter_mm = enter_mm;
+    f->exit_mm = exit_mm;
+    f->near = false;
+    f->outliers = 0;
+}
+
+bool range_filter_update(range_filter_t *f, int32_t z_mm, uint64_t now_us) {
+    uint64_t dt_us = now_us - f->last_us;
+    f->last_us = now_us;
+    int32_t dt_ms = dt_us > RF_MAX_DT_MS * 1000 ? RF_MAX_DT_MS : (int32_t)(dt_us / 1000);
+
+    if (z_mm < 0) {
+        // Sem eco: só prediz; muitas seguidas = alvo perdido
+        if (f->tracking) predict(f, dt_ms);
+        if (++f->misses >= RF_MAX_MISSES) {
+            f->tracking = false;
+            f->win_n = 0;
+            f->win_pos = 0;
+        }
+    } else {
+        f->misses = 0;
+        // Depois de um buraco a janela é de outra cena: recomeça só com
+        // a leitura nova em vez da mediana de leituras velhas
+        if (dt_ms >= RF_MAX_DT_MS) {
+            f->win_n = 0;
+            f->win_pos = 0;
+        }
+        f->win[f->win_pos] = z_mm;
+        f->win_pos = (f->win_pos + 1) % RANGE_MEDIAN_LEN;
+        if (f->win_n < RANGE_MEDIAN_LEN) f->win_n++;
+        int32_t m = median(f);
+
+        if (!f->tracking || dt_ms >= RF_MAX_DT_MS) {
+            restart(f, m);
+        } else {
+            predict(f, dt_ms);
+            if (correct(f, m)) {
+                f->rejects = 0;
+            } else {
+                f->outliers++;
+                if (++f->rejects >= RF_MAX_REJECTS) restart(f, m);
+            }
+        }
+    }
+
+    if (!f->tracking) {
+        f->near = false;
+    } else {
+        int32_t mm = range_filter_mm(f);
+        if (f->near) f->near = mm <= f->exit_mm;
+        else f->near = mm < f->enter_mm;
+    }
+    return f->near;
+}
+
+int32_t range_filter_mm(const range_filter_t *f) {
+    if (!f->tracking) return -1;
+    int32_t mm = (f->x + 128) >> 8;
+    return mm < 0 ? 0 : mm;
+}
+
+int32_t range_filter_closing_mm_s(const range_filter_t *f) {
+    if (!f->tracking) return 0;
+    return -((f->v + 128) >> 8);
+}
@@ -0,0 +1,42 @@
+#ifndef RANGE_FILTER_H
+#define RANGE_FILTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define RANGE_MEDIAN_LEN 5
+
+// Filtro das leituras do sonar: mediana deslizante contra picos, Kalman
+// de velocidade constante em ponto fixo e histerese na decisão de
+// proximidade. Posição em mm Q8, velocidade em mm/s Q8, covariâncias Q4.
+typedef struct {
+    int32_t win[RANGE_MEDIAN_LEN];
+    uint8_t win_n;
+    uint8_t win_pos;
+
+    int32_t x;        // distância, mm Q8
+    int32_t v;        // velocidade, mm/s Q8 (negativa = aproximando)
+    int32_t p00, p01, p11;
+    uint64_t last_us;
+    bool tracking;
+    uint8_t misses;   // leituras seguidas sem eco
+    uint8_t rejects;  // leituras seguidas fora do gate
+
+    uint16_t enter_mm;
+    uint16_t exit_mm;
+    bool near;
+
+    // Instrumentação
+    uint32_t outliers;
+} range_filter_t;
+
+// near liga abaixo de enter_mm e só desliga acima de exit_mm
+void range_filter_init(range_filter_t *f, uint16_t enter_mm, uint16_t exit_mm);
+// z_mm < 0: sem eco. now_us em µs desde o boot. Retorna a decisão near.
+bool range_filter_update(range_filter_t *f, int32_t z_mm, uint64_t now_us);
+// Distância filtrada em mm (-1 sem alvo)
+int32_t range_filter_mm(const range_filter_t *f);
+// Velocidade de aproximação em mm/s (positiva = chegando perto)
+int32_t range_filter_closing_mm_s(const range_filter_t *f);
+
+#endif
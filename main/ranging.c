@@ -0,0 +1,72 @@
+#include "ranging.h"
+
+static uint32_t menor_intervalo(const ping_sched_t *s, uint32_t n) {
+    uint32_t ms = s[0].interval_ms;
+    for (uint32_t i = 1; i < n; i++)
+        if (s[i].interval_ms < ms) ms = s[i].interval_ms;
+    return ms;
+}
+
+void ranging_task(void *p) {
+    ranging_t *r = p;
+    const ranging_io_t *io = r->io;
+    uint32_t n = r->n_sonares < RANGING_MAX_SONARES ? r->n_sonares : RANGING_MAX_SONARES;
+
+    range_filter_t filtros[RANGING_MAX_SONARES];
+    for (uint32_t i = 0; i < n; i++)
+        range_filter_init(&filtros[i], r->entra_mm, r->sai_mm);
+    // Um escalonador por sensor: taxa, proximidade e latência de cada um
+    // não se misturam quando outro sensor passa a ser o mais perto
+    ping_sched_t sched[RANGING_MAX_SONARES];
+    for (uint32_t i = 0; i < n; i++)
+        ping_sched_init(&sched[i], r->min_ms, r->max_ms, r->watch_mm);
+    uint32_t periodo = r->max_ms;
+    io->iniciar();
+
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(2 * r->max_ms));
+        for (uint32_t i = 0; i < n; i++) {
+            float dist;
+            uint64_t disparo;
+            if (!io->ler(i, &dist, &disparo)) continue;
+            range_filter_t *filtro = &filtros[i];
+
+            // Um eco isolado não decide mais o bloqueio: passa pelo filtro
+            int32_t mm = dist > 0 ? (int32_t)(dist * 10.0f) : -1;
+            uint64_t agora = io->agora_us();
+            bool antes = r->bloqueado;
+            // O dt do filtro é o espaçamento real dos pings, não o atraso
+            // variável entre o fim da medição e a tarefa
+            range_filter_update(filtro, mm, disparo);
+            // Bloqueia se qualquer sensor vê objeto perto
+            bool perto = false;
+            for (uint32_t j = 0; j < n; j++) perto |= filtros[j].near;
+            r->bloqueado = perto;
+            io->led(perto);
+
+            // Só o sensor 0 está no servo: o ping vai para a varredura
+            int32_t mdeg = -1;
+            if (i == 0) {
+                mdeg = io->mdeg_at(disparo);
+                ping_t ping = {mdeg, mm, (uint32_t)(agora / 1000)};
+                xQueueSend(r->pings, &ping, 0);
+            }
+
+            // O ritmo segue o sensor que pede o intervalo mais curto
+            ping_sched_update(&sched[i], filtro, mm, agora);
+            uint32_t intervalo = menor_intervalo(sched, n);
+            if (intervalo != periodo) {
+                periodo = intervalo;
+                io->set_period_ms(periodo);
+            }
+
+            if (perto && !antes) {
+                // A gravação começa sem esperar o próximo ciclo do áudio
+                xTaskNotifyGive(*r->audio);
+                // Só o filtro i mudou: foi ele que entrou no bloqueio
+                if (io->bloqueio) io->bloqueio(i, &sched[i]);
+            }
+            if (mm > 0 && io->distancia) io->distancia(i, mm, mdeg, filtro);
+        }
+    }
+}
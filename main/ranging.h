@@ -0,0 +1,64 @@
+#ifndef RANGING_H
+#define RANGING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "task.h"
+
+#include "range_filter.h"
+#include "ping_sched.h"
+
+#define RANGING_MAX_SONARES 8
+
+// Ping do sensor 0 para a varredura
+typedef struct {
+    int32_t mdeg;
+    int32_t mm;
+    uint32_t ms;
+} ping_t;
+
+// O que a tarefa de ranging usa do hardware. No firmware são os drivers
+// de sonar, o LED e o servo; no teste de host, um roteiro sobre o port
+// Posix do FreeRTOS. Os ganchos de telemetria podem ser NULL.
+typedef struct {
+    // Liga os sonares, já dentro da tarefa: o primeiro fim de medição
+    // encontra a tarefa criada
+    void (*iniciar)(void);
+    // Leitura nova do sensor i; cm < 0 sem eco válido; trigger_us é a
+    // hora do ping
+    bool (*ler)(uint32_t i, float *cm, uint64_t *trigger_us);
+    void (*set_period_ms)(uint32_t ms);
+    void (*led)(bool on);
+    // Ângulo do servo (mdeg) num instante
+    int32_t (*mdeg_at)(uint64_t us);
+    uint64_t (*agora_us)(void);
+    // Entrada no bloqueio pelo sensor i, com o escalonador dele
+    void (*bloqueio)(uint32_t i, const ping_sched_t *s);
+    void (*distancia)(uint32_t i, int32_t mm, int32_t mdeg, const range_filter_t *f);
+} ranging_io_t;
+
+// Configuração e estado compartilhado da tarefa; struct do chamador
+typedef struct {
+    const ranging_io_t *io;
+    uint32_t n_sonares;
+    uint16_t entra_mm;        // histerese do bloqueio
+    uint16_t sai_mm;
+    uint16_t min_ms;          // limites do intervalo entre pings; vale o
+                              // menor pedido entre os sensores
+    uint16_t max_ms;
+    uint16_t watch_mm;
+    QueueHandle_t pings;      // ping_t do sensor 0; cheia = o ping se perde
+    TaskHandle_t *audio;      // notificada na entrada do bloqueio
+
+    volatile bool bloqueado;  // só a tarefa escreve
+} ranging_t;
+
+// Leituras -> filtro -> LED, pings para a varredura e ritmo dos pings.
+// p é o ranging_t. A tarefa espera a notificação de fim de medição
+// (índice 0), com prazo de 2 * max_ms.
+void ranging_task(void *p);
+
+#endif
@@ -0,0 +1,73 @@
+#include "rtos_delay.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "hardware/timer.h"
+
+#include "hrtimer.h"
+#include "rtos_tick.h"
+
+#define TICK_US (1000000u / configTICK_RATE_HZ)
+
+static void acordar(hrtimer_t *t) {
+    BaseType_t acordou = pdFALSE;
+    vTaskNotifyGiveIndexedFromISR(hrtimer_get_id(t), RTOS_DELAY_NOTIFY, &acordou);
+    portYIELD_FROM_ISR(acordou);
+}
+
+void rtos_delay_us(uint32_t us) {
+    if (us < RTOS_DELAY_SPIN_US || xTaskGetSchedulerState() != taskSCHEDULER_RUNNING) {
+        busy_wait_us_32(us);
+        return;
+    }
+    uint64_t fim = time_us_64() + us;
+
+    // vTaskDelay(n) acaba entre n - 1 e n ticks depois: nunca passa do fim
+    if (us >= TICK_US) vTaskDelay(us / TICK_US);
+
+    uint64_t agora = time_us_64();
+    if (agora >= fim) return;
+    if (fim - agora < RTOS_DELAY_SPIN_US) {
+        busy_wait_until(from_us_since_boot(fim));
+        return;
+    }
+    // One-shot na pilha: o callback roda e termina antes de a tarefa voltar
+    hrtimer_t t;
+    hrtimer_init(&t, "Delay", 0, false, xTaskGetCurrentTaskHandle(), acordar, HRTIMER_ISR);
+    ulTaskNotifyTakeIndexed(RTOS_DELAY_NOTIFY, pdTRUE, 0);
+    hrtimer_start_at(&t, fim);
+    ulTaskNotifyTakeIndexed(RTOS_DELAY_NOTIFY, pdTRUE, portMAX_DELAY);
+}
+
+void rtos_delay_ms(uint32_t ms) {
+    rtos_delay_us(ms * 1000);
+}
+
+// Esperas de uma volta do laço antigo: trigger de 10 µs, 16 amostras a
+// 8 kHz e o atraso de 20 ms no fim
+static const uint32_t bench_espera_us[] = {
+    10, 125, 125, 125, 125, 125, 125, 125, 125,
+    125, 125, 125, 125, 125, 125, 125, 125, 20000,
+};
+#define BENCH_VOLTAS 10
+#define BENCH_N (sizeof(bench_espera_us) / sizeof(bench_espera_us[0]))
+
+static void bench_rodada(void (*esperar)(uint32_t), uint32_t *idle_permille, uint32_t *us) {
+    rtos_idle_window_t janela;
+    rtos_idle_begin(&janela);
+    uint64_t t0 = time_us_64();
+    for (int v = 0; v < BENCH_VOLTAS; v++)
+        for (uint32_t k = 0; k < BENCH_N; k++) esperar(bench_espera_us[k]);
+    *us = (uint32_t)(time_us_64() - t0);
+    *idle_permille = rtos_idle_permille(&janela);
+}
+
+static void girar(uint32_t us) {
+    busy_wait_us_32(us);
+}
+
+void rtos_delay_bench(rtos_delay_bench_t *r) {
+    bench_rodada(girar, &r->spin_idle_permille, &r->spin_us);
+    bench_rodada(rtos_delay_us, &r->block_idle_permille, &r->block_us);
+}
@@ -0,0 +1,32 @@
+#ifndef RTOS_DELAY_H
+#define RTOS_DELAY_H
+
+#include <stdint.h>
+
+// Esperas que bloqueiam a tarefa em vez de girar como sleep_us/sleep_ms:
+// ticks inteiros vão para vTaskDelay e o resto, abaixo de um tick, para
+// um hrtimer que acorda a tarefa pela notificação RTOS_DELAY_NOTIFY.
+// Esperas curtas demais para valer a troca de contexto, ou antes do
+// escalonador, giram. Não chamar em IRQ.
+#define RTOS_DELAY_NOTIFY 2
+// Abaixo disso gira: duas trocas de contexto custam mais que a espera
+#define RTOS_DELAY_SPIN_US 50
+
+void rtos_delay_us(uint32_t us);
+void rtos_delay_ms(uint32_t ms);
+
+// Antes e depois: as mesmas esperas do laço antigo (pulso de trigger,
+// ritmo de amostra do áudio, atraso do laço) feitas girando com
+// busy_wait_us e bloqueando com rtos_delay_us. Para cada modo, a parte
+// do tempo na tarefa idle, em milésimos, e a duração da rodada em µs.
+typedef struct {
+    uint32_t spin_idle_permille;
+    uint32_t spin_us;
+    uint32_t block_idle_permille;
+    uint32_t block_us;
+} rtos_delay_bench_t;
+
+// Chamar de uma tarefa com o escalonador rodando; leva ~0,5 s
+void rtos_delay_bench(rtos_delay_bench_t *r);
+
+#endif
@@ -0,0 +1,101 @@
+#include "rtos_tick.h"
+#include "rtos_tick_math.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "hardware/timer.h"
+
+#define TICK_US (1000000u / configTICK_RATE_HZ)
+
+// isr_systick pelo FreeRTOSConfig.h; o SysTick fica desligado
+void xPortSysTickHandler(void);
+
+static int alarm = -1;
+// Próxima borda do tick, em µs desde o boot
+static uint64_t next_tick_us;
+static rtos_tick_stats_t stats;
+
+static void set_alarm(uint64_t at_us) {
+    // true = o alvo já passou e o alarme não foi armado
+    if (hardware_alarm_set_target(alarm, from_us_since_boot(at_us)))
+        hardware_alarm_force_irq(alarm);
+}
+
+static void tick_cb(uint a) {
+    (void)a;
+    // Uma chamada por borda que passou: atraso de IRQ não perde tick, e
+    // um disparo adiantado não conta nenhum
+    for (uint32_t n = rtos_tick_due(&next_tick_us, time_us_64(), TICK_US); n; n--)
+        xPortSysTickHandler();
+    set_alarm(next_tick_us);
+}
+
+void vPortSetupTimerInterrupt(void) {
+    alarm = hardware_alarm_claim_unused(true);
+    hardware_alarm_set_callback(alarm, tick_cb);
+    // Como o SysTick no port: abaixo de todas as IRQs da aplicação
+    irq_set_priority(TIMER_IRQ_0 + alarm, PICO_LOWEST_IRQ_PRIORITY);
+    next_tick_us = time_us_64() + TICK_US;
+    set_alarm(next_tick_us);
+}
+
+// Chamado pela tarefa idle com o escalonador suspenso
+void vPortSuppressTicksAndSleep(TickType_t xExpectedIdleTime) {
+    uint32_t irq = save_and_disable_interrupts();
+    if (eTaskConfirmSleepModeStatus() == eAbortSleep) {
+        restore_interrupts(irq);
+        return;
+    }
+
+    // Só o último tick da espera acorda a CPU
+    uint64_t antes = time_us_64();
+    uint64_t wake_us = rtos_tick_wake_us(next_tick_us, xExpectedIdleTime, TICK_US);
+    set_alarm(wake_us);
+
+    // Com as IRQs mascaradas o WFI volta com qualquer IRQ pendente, mas o
+    // handler só roda depois do restore, já com o tick acertado
+    __dsb();
+    __wfi();
+    __isb();
+
+    uint64_t agora = time_us_64();
+    // Alarme disparado: a última borda (e as que passaram depois dela)
+    // fica para tick_cb, que também rearma o alarme. Acordou antes por
+    // outra IRQ: conta só as bordas que passaram e volta a ter tick a
+    // cada período.
+    TickType_t passos =
+        rtos_tick_catch_up(&next_tick_us, agora, wake_us, xExpectedIdleTime, TICK_US);
+    if (agora < wake_us) set_alarm(next_tick_us);
+    vTaskStepTick(passos);
+
+    stats.sleeps++;
+    stats.ticks_skipped += passos;
+    stats.slept_us += agora - antes;
+    restore_interrupts(irq);
+}
+
+void rtos_tick_stats(rtos_tick_stats_t *s) {
+    uint32_t irq = save_and_disable_interrupts();
+    *s = stats;
+    restore_interrupts(irq);
+}
+
+uint32_t rtos_run_time_us(void) {
+    return time_us_32();
+}
+
+void rtos_idle_begin(rtos_idle_window_t *w) {
+    w->idle_us = ulTaskGetIdleRunTimeCounter();
+    w->total_us = rtos_run_time_us();
+}
+
+uint32_t rtos_idle_permille(rtos_idle_window_t *w) {
+    // Diferenças em 32 bits: a volta do contador (71 min) não atrapalha
+    uint32_t idle = ulTaskGetIdleRunTimeCounter() - w->idle_us;
+    uint32_t total = rtos_run_time_us() - w->total_us;
+    rtos_idle_begin(w);
+    return total ? (uint32_t)((uint64_t)idle * 1000 / total) : 0;
+}
@@ -0,0 +1,37 @@
+#ifndef RTOS_TICK_H
+#define RTOS_TICK_H
+
+#include <stdint.h>
+
+// Tick do FreeRTOS num alarme do timer de 64 bits em µs, no lugar do
+// SysTick. As bordas do tick são instantes absolutos (múltiplos do
+// período desde a partida), então dormir vários ticks e recuperá-los com
+// vTaskStepTick não acumula erro. Com configUSE_TICKLESS_IDLE 1 a tarefa
+// idle dorme em WFI até a próxima tarefa acordar, sem o tick a 100 Hz.
+// Os ganchos do port (vPortSetupTimerInterrupt e
+// vPortSuppressTicksAndSleep) substituem as versões fracas de port.c.
+
+// Instrumentação: vezes que dormiu, ticks pulados e µs dormindo
+typedef struct {
+    uint32_t sleeps;
+    uint32_t ticks_skipped;
+    uint64_t slept_us;
+} rtos_tick_stats_t;
+
+void rtos_tick_stats(rtos_tick_stats_t *s);
+
+// Contador dos run-time stats do FreeRTOS: µs do timer, que segue
+// contando enquanto a CPU dorme
+uint32_t rtos_run_time_us(void);
+
+// Janela de medição do tempo na tarefa idle (dormindo ou não)
+typedef struct {
+    uint32_t idle_us;
+    uint32_t total_us;
+} rtos_idle_window_t;
+
+void rtos_idle_begin(rtos_idle_window_t *w);
+// Parte da janela na idle, em milésimos; recomeça a janela
+uint32_t rtos_idle_permille(rtos_idle_window_t *w);
+
+#endif
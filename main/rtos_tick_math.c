@@ -0,0 +1,25 @@
+#include "rtos_tick_math.h"
+
+uint32_t rtos_tick_due(uint64_t *next_tick_us, uint64_t agora, uint32_t tick_us) {
+    if (agora < *next_tick_us) return 0;
+    uint32_t n = (uint32_t)((agora - *next_tick_us) / tick_us) + 1;
+    *next_tick_us += (uint64_t)n * tick_us;
+    return n;
+}
+
+uint64_t rtos_tick_wake_us(uint64_t next_tick_us, uint32_t esperado, uint32_t tick_us) {
+    return next_tick_us + (uint64_t)(esperado - 1) * tick_us;
+}
+
+uint32_t rtos_tick_catch_up(uint64_t *next_tick_us, uint64_t agora, uint64_t wake_us,
+                            uint32_t esperado, uint32_t tick_us) {
+    uint32_t passos;
+    if (agora >= wake_us) {
+        passos = esperado - 1;
+        *next_tick_us += (uint64_t)passos * tick_us;
+    } else {
+        // Antes de wake_us passaram no máximo esperado - 1 bordas
+        passos = rtos_tick_due(next_tick_us, agora, tick_us);
+    }
+    return passos;
+}
@@ -0,0 +1,24 @@
+#ifndef RTOS_TICK_MATH_H
+#define RTOS_TICK_MATH_H
+
+#include <stdint.h>
+
+// Contas do tick de rtos_tick.c, sem hardware e sem FreeRTOS: as bordas
+// do tick são next_tick_us + k * tick_us, instantes absolutos em µs.
+
+// Bordas que já passaram em agora; avança *next_tick_us além de agora.
+// A IRQ do tick chama xPortSysTickHandler uma vez por borda.
+uint32_t rtos_tick_due(uint64_t *next_tick_us, uint64_t agora, uint32_t tick_us);
+
+// Hora de acordar de um sono de esperado ticks (>= 2): só a última borda
+// acorda a CPU
+uint64_t rtos_tick_wake_us(uint64_t next_tick_us, uint32_t esperado, uint32_t tick_us);
+
+// Volta do sono: ticks para vTaskStepTick, sempre menos que esperado, e
+// *next_tick_us avançado por eles. Se o alarme disparou (agora >= wake_us)
+// a última borda e as seguintes ficam para a IRQ do tick; senão todas as
+// bordas até agora são contadas e o chamador rearma em *next_tick_us.
+uint32_t rtos_tick_catch_up(uint64_t *next_tick_us, uint64_t agora, uint64_t wake_us,
+                            uint32_t esperado, uint32_t tick_us);
+
+#endif
@@ -0,0 +1,93 @@
+#include "scan_plan.h"
+
+#define SCAN_END_MDEG 180000
+// Região mais larga que isso não compensa: faz só varreduras completas
+#define SCAN_ROI_MAX_MDEG 90000
+
+static int32_t far_end(int32_t pos) {
+    return pos < SCAN_END_MDEG / 2 ? SCAN_END_MDEG : 0;
+}
+
+static int32_t near_end(int32_t pos) {
+    return pos < SCAN_END_MDEG / 2 ? 0 : SCAN_END_MDEG;
+}
+
+static int32_t dist(int32_t a, int32_t b) {
+    return a > b ? a - b : b - a;
+}
+
+void scan_plan_init(scan_plan_t *p, uint16_t roi_mm, uint32_t hold_ms, uint8_t dense_passes) {
+    p->roi_mm = roi_mm;
+    p->hold_ms = hold_ms;
+    p->dense_passes = dense_passes;
+    for (int i = 0; i < SCAN_SECTORS; i++) p->seen_ms[i] = 0;
+    // Começa como se voltasse à ponta: a primeira passada é completa
+    p->mode = SCAN_RETURN;
+    p->passes_left = 0;
+    p->target = 0;
+    p->roi_lo = p->roi_hi = 0;
+    p->full_sweeps = 0;
+    p->roi_passes = 0;
+}
+
+void scan_plan_observe(scan_plan_t *p, int32_t mdeg, int32_t mm, uint32_t now_ms) {
+    if (mdeg < 0 || mm < 0 || mm >= p->roi_mm) return;
+    int s = mdeg / SCAN_SECTOR_MDEG;
+    if (s >= SCAN_SECTORS) s = SCAN_SECTORS - 1;
+    p->seen_ms[s] = now_ms | 1;   // 0 fica reservado para "nunca"
+}
+
+bool scan_plan_roi(const scan_plan_t *p, uint32_t now_ms, int32_t *lo, int32_t *hi) {
+    int first = -1, last = -1;
+    for (int s = 0; s < SCAN_SECTORS; s++) {
+        if (!p->seen_ms[s] || now_ms - p->seen_ms[s] > p->hold_ms) continue;
+        if (first < 0) first = s;
+        last = s;
+    }
+    if (first < 0) return false;
+
+    // Um setor de margem de cada lado segue o objeto que se move
+    int32_t a = (first - 1) * SCAN_SECTOR_MDEG;
+    int32_t b = (last + 2) * SCAN_SECTOR_MDEG;
+    if (a < 0) a = 0;
+    if (b > SCAN_END_MDEG) b = SCAN_END_MDEG;
+    if (b - a > SCAN_ROI_MAX_MDEG) return false;
+    *lo = a;
+    *hi = b;
+    return true;
+}
+
+int32_t scan_plan_next(scan_plan_t *p, int32_t pos_mdeg, uint32_t now_ms) {
+    bool roi = p->dense_passes && scan_plan_roi(p, now_ms, &p->roi_lo, &p->roi_hi);
+
+    switch (p->mode) {
+    case SCAN_FULL:
+        p->full_sweeps++;
+        if (roi) {
+            // Entra pela borda mais perto da região
+            p->mode = SCAN_ROI;
+            p->passes_left = p->dense_passes;
+            p->target = dist(pos_mdeg, p->roi_lo) < dist(pos_mdeg, p->roi_hi) ? p->roi_lo
+                                                                             : p->roi_hi;
+        } else {
+            p->target = far_end(pos_mdeg);
+        }
+        break;
+    case SCAN_ROI:
+        if (roi && p->passes_left) {
+            p->passes_left--;
+            p->roi_passes++;
+            p->target = dist(pos_mdeg, p->roi_lo) < dist(pos_mdeg, p->roi_hi) ? p->roi_hi
+                                                                             : p->roi_lo;
+        } else {
+            p->mode = SCAN_RETURN;
+            p->target = near_end(pos_mdeg);
+        }
+        break;
+    case SCAN_RETURN:
+        p->mode = SCAN_FULL;
+        p->target = far_end(pos_mdeg);
+        break;
+    }
+    return p->target;
+}
@@ -0,0 +1,45 @@
+#ifndef SCAN_PLAN_H
+#define SCAN_PLAN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Setores de 10° para lembrar onde houve eco
+#define SCAN_SECTORS 18
+#define SCAN_SECTOR_MDEG (180000 / SCAN_SECTORS)
+
+typedef enum {
+    SCAN_FULL,    // varredura grossa de uma ponta à outra
+    SCAN_ROI,     // vai e volta denso na região de interesse
+    SCAN_RETURN,  // volta à ponta mais perto para a próxima grossa
+} scan_mode_t;
+
+// Planejador de varredura foveada: intercala uma passada completa com
+// algumas passadas curtas sobre os setores que tiveram eco recente, na
+// mesma velocidade de servo. Só lógica inteira, sem hardware: roda
+// igual numa simulação no host.
+typedef struct {
+    uint16_t roi_mm;        // eco mais perto que isso marca o setor
+    uint32_t hold_ms;       // o setor fica marcado por esse tempo
+    uint8_t dense_passes;   // passadas na região entre duas grossas (0 = uniforme)
+
+    uint32_t seen_ms[SCAN_SECTORS];   // último eco no setor (0 = nunca)
+    scan_mode_t mode;
+    uint8_t passes_left;
+    int32_t target;
+    int32_t roi_lo, roi_hi;
+
+    // Instrumentação
+    uint32_t full_sweeps;
+    uint32_t roi_passes;
+} scan_plan_t;
+
+void scan_plan_init(scan_plan_t *p, uint16_t roi_mm, uint32_t hold_ms, uint8_t dense_passes);
+// Um ping com o ângulo do trigger; mm < 0 = sem eco
+void scan_plan_observe(scan_plan_t *p, int32_t mdeg, int32_t mm, uint32_t now_ms);
+// O servo chegou ao alvo anterior (em pos_mdeg): próximo alvo em mdeg
+int32_t scan_plan_next(scan_plan_t *p, int32_t pos_mdeg, uint32_t now_ms);
+// Região de interesse atual; false se não há setor marcado
+bool scan_plan_roi(const scan_plan_t *p, uint32_t now_ms, int32_t *lo, int32_t *hi);
+
+#endif
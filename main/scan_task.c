@@ -0,0 +1,39 @@
+#include "scan_task.h"
+
+#include "scan_plan.h"
+
+void scan_task(void *p) {
+    scan_task_t *s = p;
+    const scan_io_t *io = s->io;
+    int8_t dir = 1;
+    int32_t alvo = 0;
+    bool parado = false;
+    scan_plan_t plano;
+    scan_plan_init(&plano, s->watch_mm, s->marca_ms, s->passadas);
+    io->assentar();
+
+    while (true) {
+        ping_t ping;
+        TickType_t espera = pdMS_TO_TICKS(s->quadro_ms);
+        while (xQueueReceive(s->pings, &ping, espera) == pdTRUE) {
+            scan_plan_observe(&plano, ping.mdeg, ping.mm, ping.ms);
+            if (io->ping) io->ping(&ping);
+            espera = 0;
+        }
+
+        if (s->ranging->bloqueado) {
+            if (!parado) io->parar();
+            parado = true;
+        } else if (parado) {
+            // Retoma a passada de onde parou
+            io->mover(alvo);
+            parado = false;
+        } else if (io->chegou()) {
+            int32_t pos = io->mdeg();
+            if (io->fim_passada) io->fim_passada(dir);
+            alvo = scan_plan_next(&plano, pos, io->agora_ms());
+            dir = alvo >= pos ? 1 : -1;
+            io->mover(alvo);
+        }
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef SCAN_TASK_H
+#define SCAN_TASK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "FreeRTOS.h"
+#include "queue.h"
+
+#include "ranging.h"
+
+// O que a tarefa de varredura usa do hardware. No firmware é o servo com
+// perfil de movimento no timer e o radar; no teste de host, um servo de
+// mentira que anda a cada passo do roteiro. Os ganchos do radar podem
+// ser NULL.
+typedef struct {
+    // Espera o servo chegar à posição inicial, antes da primeira passada
+    void (*assentar)(void);
+    int32_t (*mdeg)(void);
+    bool (*chegou)(void);
+    void (*mover)(int32_t mdeg);
+    void (*parar)(void);
+    uint32_t (*agora_ms)(void);
+    void (*ping)(const ping_t *p);
+    // Fim de uma passada, completa ou só na região de interesse
+    void (*fim_passada)(int8_t dir);
+} scan_io_t;
+
+// Configuração da tarefa; struct do chamador
+typedef struct {
+    const scan_io_t *io;
+    QueueHandle_t pings;        // ping_t do sensor 0, da tarefa de ranging
+    const ranging_t *ranging;   // o servo para enquanto bloqueado
+    uint16_t watch_mm;          // parâmetros do scan_plan
+    uint32_t marca_ms;
+    uint8_t passadas;
+    uint32_t quadro_ms;         // prazo para escolher alvo sem pings
+} scan_task_t;
+
+// Escolhe o alvo do servo a cada quadro; o timer de hardware faz o
+// movimento. p é o scan_task_t.
+void scan_task(void *p);
+
+#endif
@@ -0,0 +1,139 @@
+#include "servo_motion.h"
+
+#include "hardware/sync.h"
+
+#include "hrtimer.h"
+#include "servo_out.h"
+
+#define SERVO_FRAMES_PER_S (1000000 / SERVO_FRAME_US)
+
+static servo_motion_t *axes[SERVO_MOTION_MAX];
+static uint n_axes;
+static hrtimer_t timer;
+
+static void write_level(const servo_motion_t *m) {
+    servo_out_set(m->ch, m->pos);
+}
+
+static int32_t clamp_mdeg(int32_t mdeg) {
+    if (mdeg < 0) return 0;
+    if (mdeg > SERVO_MDEG_MAX) return SERVO_MDEG_MAX;
+    return mdeg;
+}
+
+static void step(servo_motion_t *m) {
+    int32_t err = m->target - m->pos;
+    int32_t v = m->vel;
+    if (err == 0 && v == 0) {
+        m->moving = false;
+        return;
+    }
+    m->moving = true;
+
+    int32_t dir = err > 0 ? 1 : -1;
+    int32_t speed = v * dir;   // positiva = indo para o alvo
+    int32_t dist = err * dir;
+    // Distância para parar freando a acc por quadro: v + (v - a) + ... + a
+    int32_t stop = speed > 0 ? speed * (speed + m->acc) / (2 * m->acc) : 0;
+
+    if (speed < 0) {
+        speed += m->acc;  // indo para o lado errado: freia primeiro
+    } else if (dist <= stop) {
+        speed -= m->acc;
+        // Arredondamento deixou um resto: chega devagar
+        if (speed <= 0) speed = dist < m->acc ? dist : m->acc;
+    } else {
+        speed += m->acc;
+    }
+    if (speed > m->vmax) speed = m->vmax;
+    // Último quadro: para no alvo se a freada couber na aceleração
+    if (speed > dist && speed - dist <= m->acc) speed = dist;
+
+    m->vel = speed * dir;
+    m->pos = clamp_mdeg(m->pos + m->vel);
+    if (m->pos == m->target && (m->vel * dir) <= m->acc) m->vel = 0;
+    write_level(m);
+}
+
+static void tick(hrtimer_t *t) {
+    // Todos os eixos vão para a sombra do servo_out na mesma chamada e
+    // mudam juntos na próxima borda do PWM
+    uint64_t now = time_us_64();
+    for (uint i = 0; i < n_axes; i++) {
+        servo_motion_t *m = axes[i];
+        step(m);
+        m->hist_pos = (m->hist_pos + 1) % SERVO_HIST_LEN;
+        m->hist[m->hist_pos] = m->pos;
+        m->hist_us = now;
+    }
+}
+
+void servo_motion_init(servo_motion_t *m, uint ch, uint32_t vmax_deg_s, uint32_t acc_deg_s2,
+                       uint32_t start_deg) {
+    m->ch = ch;
+    m->pos = m->target = clamp_mdeg(start_deg * 1000);
+    m->vel = 0;
+    m->vmax = vmax_deg_s * 1000 / SERVO_FRAMES_PER_S;
+    m->acc = acc_deg_s2 * 1000 / (SERVO_FRAMES_PER_S * SERVO_FRAMES_PER_S);
+    if (m->vmax < 1) m->vmax = 1;
+    if (m->acc < 1) m->acc = 1;
+    m->moving = false;
+    for (uint i = 0; i < SERVO_HIST_LEN; i++) m->hist[i] = m->pos;
+    m->hist_pos = 0;
+    m->hist_us = time_us_64();
+    write_level(m);
+
+    uint32_t irq = save_and_disable_interrupts();
+    if (n_axes < SERVO_MOTION_MAX) axes[n_axes++] = m;
+    restore_interrupts(irq);
+}
+
+void servo_motion_start(void) {
+    // Na IRQ do alarme: o passo é curto e não chama o FreeRTOS
+    hrtimer_init(&timer, "Servo", SERVO_FRAME_US, true, NULL, tick, HRTIMER_ISR);
+    hrtimer_start(&timer);
+}
+
+void servo_motion_move_to(servo_motion_t *m, int32_t mdeg) {
+    m->target = clamp_mdeg(mdeg);
+    m->moving = true;
+}
+
+void servo_motion_halt(servo_motion_t *m) {
+    uint32_t irq = save_and_disable_interrupts();
+    int32_t v = m->vel;
+    int32_t speed = v < 0 ? -v : v;
+    int32_t stop = speed * (speed + m->acc) / (2 * m->acc);
+    m->target = clamp_mdeg(m->pos + (v < 0 ? -stop : stop));
+    restore_interrupts(irq);
+}
+
+bool servo_motion_done(const servo_motion_t *m) {
+    return !m->moving;
+}
+
+int32_t servo_motion_mdeg(const servo_motion_t *m) {
+    return m->pos;
+}
+
+int32_t servo_motion_mdeg_at(const servo_motion_t *m, uint64_t t_us) {
+    uint32_t irq = save_and_disable_interrupts();
+    int32_t mdeg;
+    if (t_us >= m->hist_us) {
+        mdeg = m->pos;
+    } else {
+        uint64_t back = m->hist_us - t_us;
+        uint32_t frames = back / SERVO_FRAME_US;
+        if (frames >= SERVO_HIST_LEN - 1) {
+            mdeg = m->hist[(m->hist_pos + 1) % SERVO_HIST_LEN];
+        } else {
+            // a: quadro depois de t, b: quadro antes de t
+            int32_t a = m->hist[(m->hist_pos + SERVO_HIST_LEN - frames) % SERVO_HIST_LEN];
+            int32_t b = m->hist[(m->hist_pos + SERVO_HIST_LEN - frames - 1) % SERVO_HIST_LEN];
+            uint32_t frac = back % SERVO_FRAME_US;
+            mdeg = a + (b - a) * (int32_t)frac / SERVO_FRAME_US;
+        }
+    }
+    restore_interrupts(irq);
+    return mdeg;
+}
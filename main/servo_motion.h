@@ -0,0 +1,49 @@
+#ifndef SERVO_MOTION_H
+#define SERVO_MOTION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+
+// Eixos atendidos pelo mesmo timer
+#define SERVO_MOTION_MAX 4
+// Quadro do PWM do servo (50 Hz)
+#define SERVO_FRAME_US 20000
+// Posições guardadas, uma por quadro: 160 ms de histórico
+#define SERVO_HIST_LEN 8
+
+// Perfil trapezoidal por eixo: acelera até a velocidade máxima, cruza e
+// freia para parar no alvo. Posição em milésimos de grau; velocidade e
+// aceleração por quadro de 20 ms.
+typedef struct {
+    uint ch;                  // canal do servo_out
+    volatile int32_t target;  // mdeg, escrito por qualquer tarefa
+    volatile int32_t pos;     // mdeg, só o timer escreve
+    int32_t vel;              // mdeg/quadro, com sinal
+    int32_t vmax;             // mdeg/quadro
+    int32_t acc;              // mdeg/quadro²
+    volatile bool moving;
+
+    // Posição comandada nos últimos quadros, para achar o ângulo na
+    // hora de um evento que só é lido depois
+    int32_t hist[SERVO_HIST_LEN];
+    uint8_t hist_pos;
+    uint64_t hist_us;         // hora do quadro em hist[hist_pos]
+} servo_motion_t;
+
+// Registra o eixo de um canal do servo_out e o leva a start_deg
+void servo_motion_init(servo_motion_t *m, uint ch, uint32_t vmax_deg_s, uint32_t acc_deg_s2,
+                       uint32_t start_deg);
+// Liga o timer de hardware que avança todos os eixos a cada quadro
+void servo_motion_start(void);
+// Novo alvo; não bloqueia e pode trocar no meio do movimento
+void servo_motion_move_to(servo_motion_t *m, int32_t mdeg);
+// Freia o mais rápido que a aceleração permite e para onde chegar
+void servo_motion_halt(servo_motion_t *m);
+bool servo_motion_done(const servo_motion_t *m);
+int32_t servo_motion_mdeg(const servo_motion_t *m);
+// Posição comandada em t_us (µs desde o boot), interpolada entre quadros;
+// fora do histórico devolve o extremo mais próximo
+int32_t servo_motion_mdeg_at(const servo_motion_t *m, uint64_t t_us);
+
+#endif
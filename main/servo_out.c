@@ -0,0 +1,98 @@
+#include "servo_out.h"
+
+#include "hardware/irq.h"
+#include "hardware/pwm.h"
+#include "hardware/sync.h"
+
+typedef struct {
+    uint pin;
+    uint slice;
+    uint chan;   // PWM_CHAN_A ou PWM_CHAN_B
+    const servo_cal_t *cal;
+} servo_ch_t;
+
+static servo_ch_t chans[SERVO_OUT_MAX];
+static uint n_chans;
+static uint32_t slice_mask;
+static int master = -1;   // slice cuja IRQ de wrap marca o quadro
+
+// Sombra do registrador CC de cada slice (B nos 16 bits altos)
+static uint32_t shadow[NUM_PWM_SLICES];
+static volatile uint32_t dirty;   // bit s = slice s com nível novo
+static volatile uint32_t frames;
+
+static void wrap_irq(void) {
+    if (!(pwm_get_irq_status_mask() & (1u << master))) return;
+    pwm_clear_irq(master);
+    frames++;
+
+    // Acabou de passar uma borda: o CC escrito agora vale na próxima,
+    // em todos os slices ao mesmo tempo
+    uint32_t d = dirty;
+    dirty = 0;
+    for (uint s = 0; d; s++, d >>= 1)
+        if (d & 1) pwm_hw->slice[s].cc = shadow[s];
+}
+
+static void put_level(const servo_ch_t *c, int32_t mdeg) {
+    uint32_t level = servo_pulse_level(c->cal, mdeg);
+    uint shift = c->chan == PWM_CHAN_B ? 16 : 0;
+    shadow[c->slice] = (shadow[c->slice] & ~(0xffffu << shift)) | (level << shift);
+    dirty |= 1u << c->slice;
+}
+
+int servo_out_add(uint pin, const servo_cal_t *cal, int32_t start_mdeg) {
+    if (n_chans >= SERVO_OUT_MAX) return -1;
+    servo_ch_t *c = &chans[n_chans];
+    c->pin = pin;
+    c->slice = pwm_gpio_to_slice_num(pin);
+    c->chan = pwm_gpio_to_channel(pin);
+    c->cal = cal;
+    slice_mask |= 1u << c->slice;
+    if (master < 0) master = c->slice;
+    put_level(c, start_mdeg);
+    return n_chans++;
+}
+
+void servo_out_start(void) {
+    pwm_config config = pwm_get_default_config();
+    pwm_config_set_clkdiv(&config, SERVO_PWM_CLKDIV);
+    pwm_config_set_wrap(&config, SERVO_PWM_WRAP); // 50Hz
+
+    for (uint s = 0; s < NUM_PWM_SLICES; s++) {
+        if (!(slice_mask & (1u << s))) continue;
+        // Contador zerado e parado até o enable conjunto
+        pwm_init(s, &config, false);
+        pwm_hw->slice[s].cc = shadow[s];
+    }
+    dirty = 0;
+    for (uint i = 0; i < n_chans; i++) gpio_set_function(chans[i].pin, GPIO_FUNC_PWM);
+
+    pwm_clear_irq(master);
+    pwm_set_irq_enabled(master, true);
+    irq_add_shared_handler(PWM_IRQ_WRAP, wrap_irq, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(PWM_IRQ_WRAP, true);
+
+    // Mesmo instante de partida: as bordas de todos os slices coincidem
+    pwm_set_mask_enabled(pwm_hw->en | slice_mask);
+}
+
+void servo_out_set(uint ch, int32_t mdeg) {
+    if (ch >= n_chans) return;
+    uint32_t irq = save_and_disable_interrupts();
+    put_level(&chans[ch], mdeg);
+    restore_interrupts(irq);
+}
+
+void servo_out_set_batch(uint first, const int32_t *mdeg, uint n) {
+    if (first >= n_chans) return;
+    if (n > n_chans - first) n = n_chans - first;
+    // A IRQ de wrap não vê o lote pela metade
+    uint32_t irq = save_and_disable_interrupts();
+    for (uint i = 0; i < n; i++) put_level(&chans[first + i], mdeg[i]);
+    restore_interrupts(irq);
+}
+
+uint32_t servo_out_frames(void) {
+    return frames;
+}
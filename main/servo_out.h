@@ -0,0 +1,29 @@
+#ifndef SERVO_OUT_H
+#define SERVO_OUT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+
+#include "servo_pulse.h"
+
+// Dois canais por slice de PWM, oito slices
+#define SERVO_OUT_MAX 16
+
+// Saída de vários servos nos slices de PWM. Todos os slices usados
+// rodam em fase; os níveis novos ficam numa sombra e a IRQ de wrap os
+// copia para os registradores logo depois de uma borda, então todos os
+// canais mudam juntos na borda seguinte. Pinos no slice do áudio
+// (12, 13, 28, 29) não podem ser usados.
+//
+// Registra um servo; retorna o canal ou -1 se a tabela está cheia
+int servo_out_add(uint pin, const servo_cal_t *cal, int32_t start_mdeg);
+// Configura os slices e liga todos na mesma borda
+void servo_out_start(void);
+void servo_out_set(uint ch, int32_t mdeg);
+// Canais first .. first + n - 1 no mesmo quadro
+void servo_out_set_batch(uint first, const int32_t *mdeg, uint n);
+// Quadros de 20 ms desde o start
+uint32_t servo_out_frames(void);
+
+#endif
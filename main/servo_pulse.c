@@ -0,0 +1,45 @@
+#include "servo_pulse.h"
+
+#include "hardware/sync.h"
+
+#include "cycle_count.h"
+
+#define BENCH_CALLS 64
+
+// Caminho antigo do set_servo_angle: divisão e multiplicação em float,
+// que no M0+ viram chamadas da biblioteca de float em software
+static uint16_t __noinline float_level(float angle_deg) {
+    float pulse_ms = 1.0f + (angle_deg / 180.0f);
+    return (uint16_t)(pulse_ms * 1953.1f);
+}
+
+static uint16_t __noinline fixed_level(const servo_cal_t *cal, int32_t mdeg) {
+    return servo_pulse_level(cal, mdeg);
+}
+
+void servo_pulse_bench(uint32_t *float_cycles, uint32_t *fixed_cycles) {
+    static const servo_cal_t cal = SERVO_CAL_DEFAULT;
+    static float deg[BENCH_CALLS];
+    static int32_t mdeg[BENCH_CALLS];
+    volatile uint16_t sink;
+
+    // Entradas prontas antes de medir: o laço só conta a conversão
+    for (int i = 0; i < BENCH_CALLS; i++) {
+        mdeg[i] = i * (SERVO_MDEG_MAX / BENCH_CALLS);
+        deg[i] = mdeg[i] / 1000.0f;
+    }
+
+    cycle_count_start();
+
+    uint32_t irq = save_and_disable_interrupts();
+    uint32_t t0 = cycle_count_now();
+    for (int i = 0; i < BENCH_CALLS; i++) sink = float_level(deg[i]);
+    uint32_t t1 = cycle_count_now();
+    for (int i = 0; i < BENCH_CALLS; i++) sink = fixed_level(&cal, mdeg[i]);
+    uint32_t t2 = cycle_count_now();
+    restore_interrupts(irq);
+    (void)sink;
+
+    *float_cycles = cycle_count_elapsed(t0, t1) / BENCH_CALLS;
+    *fixed_cycles = cycle_count_elapsed(t1, t2) / BENCH_CALLS;
+}
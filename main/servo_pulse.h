@@ -0,0 +1,41 @@
+#ifndef SERVO_PULSE_H
+#define SERVO_PULSE_H
+
+#include <stdint.h>
+
+// PWM do servo: 125 MHz / 64 e 39062 níveis por quadro = 50 Hz
+#define SERVO_PWM_CLKDIV 64
+#define SERVO_PWM_WRAP 39062
+#define SERVO_MDEG_MAX 180000
+// Níveis de PWM por µs de pulso, arredondado
+#define SERVO_US_TO_LEVEL(us) (((us) * 125u + 32u) / 64u)
+
+// Calibração de um servo: nível do pulso em 0° e níveis por mdeg em Q16.
+// SERVO_CAL é constante, então a tabela de servos sai pronta do compilador.
+typedef struct {
+    uint16_t base;
+    uint16_t slope_q16;
+} servo_cal_t;
+
+#define SERVO_CAL(min_us, max_us)                                          \
+    {                                                                      \
+        .base = SERVO_US_TO_LEVEL(min_us),                                 \
+        .slope_q16 = (((max_us) - (min_us)) * 125ull * 65536 / 64 +        \
+                      SERVO_MDEG_MAX / 2) / SERVO_MDEG_MAX,                \
+    }
+
+// Pulso padrão de 1 ms a 2 ms
+#define SERVO_CAL_DEFAULT SERVO_CAL(1000, 2000)
+
+// Nível de PWM para mdeg (0 a 180000): só inteiros, uma multiplicação
+static inline uint16_t servo_pulse_level(const servo_cal_t *cal, int32_t mdeg) {
+    if (mdeg < 0) mdeg = 0;
+    if (mdeg > SERVO_MDEG_MAX) mdeg = SERVO_MDEG_MAX;
+    return cal->base + (((uint32_t)mdeg * cal->slope_q16 + 0x8000) >> 16);
+}
+
+// Ciclos por chamada do caminho em float antigo e de servo_pulse_level,
+// medidos com o SysTick (o tick do FreeRTOS está num alarme do timer).
+void servo_pulse_bench(uint32_t *float_cycles, uint32_t *fixed_cycles);
+
+#endif
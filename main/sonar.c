@@ -0,0 +1,168 @@
+#include "sonar.h"
+
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "hardware/timer.h"
+
+#include "hrtimer.h"
+
+static uint trig;
+static uint echo;
+static int alarm = -1;
+static hrtimer_t pulse;  // one-shot que baixa o trigger
+static sonar_cb_t done_cb = NULL;
+
+static volatile sonar_state_t state = SONAR_IDLE;
+static volatile bool continuous = false;
+static sonar_reading_t cur;
+static sonar_reading_t last;
+static volatile bool fresh = false;
+static uint64_t last_trigger_us;
+static volatile uint32_t period_us = SONAR_MIN_PERIOD_US;
+
+static void pulse_end(hrtimer_t *t) {
+    (void)t;
+    gpio_put(trig, 0);
+}
+
+static void trigger(void) {
+    cur.trigger_us = time_us_64();
+    cur.rise_us = cur.fall_us = 0;
+    cur.echo_us = 0;
+    cur.ok = false;
+    last_trigger_us = cur.trigger_us;
+    state = SONAR_WAIT_RISE;
+
+    // O pulso acaba na IRQ do hrtimer, sem girar aqui; o sensor só emite
+    // o burst ~200 µs depois da descida, então o eco não chega antes
+    gpio_put(trig, 1);
+    hrtimer_start_at(&pulse, cur.trigger_us + SONAR_TRIG_US);
+    sonar_set_alarm(alarm, cur.trigger_us + SONAR_TIMEOUT_US);
+}
+
+static void schedule_next(void) {
+    uint64_t next = time_us_64() + SONAR_GAP_US;
+    if (next < last_trigger_us + period_us)
+        next = last_trigger_us + period_us;
+    state = SONAR_HOLDOFF;
+    sonar_set_alarm(alarm, next);
+}
+
+static void finish(bool ok) {
+    cur.ok = ok && cur.echo_us <= SONAR_MAX_ECHO_US;
+    last = cur;
+    fresh = true;
+    if (done_cb) done_cb(&last);
+
+    if (continuous) schedule_next();
+    else state = SONAR_IDLE;
+}
+
+static void alarm_cb(uint a) {
+    switch (state) {
+    case SONAR_WAIT_RISE:
+    case SONAR_ECHO:
+        finish(false);
+        break;
+    case SONAR_HOLDOFF:
+        // Sem objeto o sensor segura o eco por ~38 ms: espera baixar
+        if (gpio_get(echo)) sonar_set_alarm(alarm, time_us_64() + SONAR_GAP_US);
+        else trigger();
+        break;
+    default:
+        break;
+    }
+}
+
+static void echo_irq(void) {
+    uint32_t ev = gpio_get_irq_event_mask(echo);
+    if (!ev) return;
+    gpio_acknowledge_irq(echo, ev);
+    uint64_t now = time_us_64();
+
+    if ((ev & GPIO_IRQ_EDGE_RISE) && state == SONAR_WAIT_RISE) {
+        cur.rise_us = now;
+        state = SONAR_ECHO;
+    }
+    if ((ev & GPIO_IRQ_EDGE_FALL) && state == SONAR_ECHO) {
+        hardware_alarm_cancel(alarm);
+        cur.fall_us = now;
+        cur.echo_us = now - cur.rise_us;
+        finish(true);
+    }
+}
+
+void sonar_init(uint trig_pin, uint echo_pin, sonar_cb_t cb) {
+    trig = trig_pin;
+    echo = echo_pin;
+    done_cb = cb;
+
+    gpio_init(trig);
+    gpio_set_dir(trig, GPIO_OUT);
+    gpio_put(trig, 0);
+    gpio_init(echo);
+    gpio_set_dir(echo, GPIO_IN);
+
+    alarm = hardware_alarm_claim_unused(true);
+    hardware_alarm_set_callback(alarm, alarm_cb);
+    hrtimer_init(&pulse, "SonarTrig", SONAR_TRIG_US, false, NULL, pulse_end, HRTIMER_ISR);
+
+    // Handler só deste pino: não toma o callback de GPIO compartilhado
+    gpio_add_raw_irq_handler(echo, echo_irq);
+    gpio_set_irq_enabled(echo, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true);
+    irq_set_enabled(IO_IRQ_BANK0, true);
+}
+
+bool sonar_start_measurement(void) {
+    bool started = false;
+    uint32_t irq = save_and_disable_interrupts();
+    if (state == SONAR_IDLE && !gpio_get(echo) &&
+        time_us_64() >= last_trigger_us + period_us) {
+        trigger();
+        started = true;
+    }
+    restore_interrupts(irq);
+    return started;
+}
+
+void sonar_start_continuous(void) {
+    uint32_t irq = save_and_disable_interrupts();
+    continuous = true;
+    if (state == SONAR_IDLE) schedule_next();
+    restore_interrupts(irq);
+}
+
+void sonar_set_period_ms(uint32_t ms) {
+    uint32_t us = ms * 1000;
+    period_us = us < SONAR_MIN_PERIOD_US ? SONAR_MIN_PERIOD_US : us;
+}
+
+void sonar_stop(void) {
+    uint32_t irq = save_and_disable_interrupts();
+    continuous = false;
+    hardware_alarm_cancel(alarm);
+    hrtimer_stop(&pulse);
+    gpio_put(trig, 0);
+    state = SONAR_IDLE;
+    restore_interrupts(irq);
+}
+
+bool sonar_poll(sonar_reading_t *r) {
+    uint32_t irq = save_and_disable_interrupts();
+    bool got = fresh;
+    if (got) {
+        *r = last;
+        fresh = false;
+    }
+    restore_interrupts(irq);
+    return got;
+}
+
+bool sonar_busy(void) {
+    return state != SONAR_IDLE;
+}
+
+float sonar_echo_to_cm(uint32_t echo_us) {
+    return echo_us * 0.017015f;
+}
@@ -0,0 +1,61 @@
+#ifndef SONAR_H
+#define SONAR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+#include "hardware/timer.h"
+
+// Tempos do HC-SR04, comuns aos três drivers (sonar, tabela e PIO)
+#define SONAR_TRIG_US 10
+// 400 cm ida e volta (~23,5 ms) mais o atraso do burst
+#define SONAR_MAX_ECHO_US 23500
+#define SONAR_TIMEOUT_US 25000
+// Silêncio depois do eco para a reverberação morrer
+#define SONAR_GAP_US 10000
+// Período mínimo entre triggers: ~40 Hz com objetos próximos
+#define SONAR_MIN_PERIOD_US 25000
+
+typedef enum {
+    SONAR_IDLE,
+    SONAR_WAIT_RISE,  // trigger enviado, esperando o eco subir
+    SONAR_ECHO,       // eco alto, esperando a descida
+    SONAR_HOLDOFF,    // modo contínuo: esperando a hora do próximo trigger
+} sonar_state_t;
+
+// Tempos em µs desde o boot (64 bits: não dão a volta)
+typedef struct {
+    uint64_t trigger_us;
+    uint64_t rise_us;
+    uint64_t fall_us;
+    uint32_t echo_us;  // largura do eco
+    bool ok;           // false em timeout ou eco além do alcance
+} sonar_reading_t;
+
+// Arma o alarme de hardware para um instante absoluto; se o alvo já
+// passou o alarme não é armado, então a IRQ é forçada na hora
+static inline void sonar_set_alarm(uint alarm, uint64_t at_us) {
+    if (hardware_alarm_set_target(alarm, from_us_since_boot(at_us)))
+        hardware_alarm_force_irq(alarm);
+}
+
+// Chamado na IRQ ao fim de cada medição
+typedef void (*sonar_cb_t)(const sonar_reading_t *r);
+
+// Medição assíncrona do HC-SR04: bordas do eco por IRQ de GPIO e timeout
+// num alarme de hardware; nada bloqueia esperando o eco.
+void sonar_init(uint trig_pin, uint echo_pin, sonar_cb_t cb);
+// Dispara uma medição; false se ocupado ou cedo demais desde a anterior
+bool sonar_start_measurement(void);
+// Mede em sequência: o próximo trigger sai logo que o eco termina,
+// respeitando o período mínimo, então a taxa acompanha a distância
+void sonar_start_continuous(void);
+// Período entre triggers no modo contínuo (mínimo de 25 ms)
+void sonar_set_period_ms(uint32_t ms);
+void sonar_stop(void);
+// Copia a última leitura; true só se ela ainda não tinha sido lida
+bool sonar_poll(sonar_reading_t *r);
+bool sonar_busy(void);
+float sonar_echo_to_cm(uint32_t echo_us);
+
+#endif
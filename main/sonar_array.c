@@ -0,0 +1,219 @@
+#include "sonar_array.h"
+
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "hardware/timer.h"
+
+#include "hrtimer.h"
+
+typedef enum {
+    ARRAY_IDLE,
+    ARRAY_MEASURING,  // grupo disparado, esperando os ecos ou o timeout
+    ARRAY_HOLDOFF,    // esperando a hora do próximo grupo
+} array_state_t;
+
+typedef struct {
+    uint trig;
+    uint echo;
+    sonar_state_t state;
+    sonar_reading_t cur;
+    sonar_reading_t last;
+    volatile bool fresh;
+} sensor_t;
+
+static sensor_t sensors[SONAR_ARRAY_MAX];
+static uint count;
+static uint n_groups;
+static uint32_t group_trig_mask[SONAR_ARRAY_MAX];
+static uint32_t group_echo_mask[SONAR_ARRAY_MAX];
+static uint64_t group_last_us[SONAR_ARRAY_MAX];
+static int alarm = -1;
+static hrtimer_t pulse;       // one-shot que baixa os triggers
+static uint32_t pulse_mask;   // triggers em alta
+static sonar_array_cb_t done_cb = NULL;
+
+static volatile array_state_t state = ARRAY_IDLE;
+static uint group;
+static uint32_t pending;  // bit i = sensor i ainda medindo
+static volatile uint32_t readings;
+static volatile uint32_t period_us = SONAR_MIN_PERIOD_US;
+
+static void pulse_end(hrtimer_t *t) {
+    (void)t;
+    gpio_clr_mask(pulse_mask);
+    pulse_mask = 0;
+}
+
+static void trigger_group(void) {
+    uint64_t now = time_us_64();
+    pending = 0;
+    for (uint i = group; i < count; i += n_groups) {
+        sensor_t *s = &sensors[i];
+        s->cur.trigger_us = now;
+        s->cur.rise_us = s->cur.fall_us = 0;
+        s->cur.echo_us = 0;
+        s->cur.ok = false;
+        s->state = SONAR_WAIT_RISE;
+        pending |= 1u << i;
+    }
+    group_last_us[group] = now;
+    state = ARRAY_MEASURING;
+
+    // Todos os triggers do grupo sobem juntos e descem juntos na IRQ do
+    // hrtimer, sem girar aqui
+    pulse_mask = group_trig_mask[group];
+    gpio_set_mask(pulse_mask);
+    hrtimer_start_at(&pulse, now + SONAR_TRIG_US);
+    sonar_set_alarm(alarm, now + SONAR_TIMEOUT_US);
+}
+
+static void schedule_next(void) {
+    group = (group + 1) % n_groups;
+    uint64_t next = time_us_64() + SONAR_GAP_US;
+    if (next < group_last_us[group] + period_us)
+        next = group_last_us[group] + period_us;
+    state = ARRAY_HOLDOFF;
+    sonar_set_alarm(alarm, next);
+}
+
+static void finish(uint i, bool ok) {
+    sensor_t *s = &sensors[i];
+    s->cur.ok = ok && s->cur.echo_us <= SONAR_MAX_ECHO_US;
+    s->last = s->cur;
+    s->fresh = true;
+    s->state = SONAR_IDLE;
+    pending &= ~(1u << i);
+    readings++;
+    if (done_cb) done_cb(i, &s->last);
+}
+
+static void alarm_cb(uint a) {
+    switch (state) {
+    case ARRAY_MEASURING:
+        for (uint i = 0; i < count; i++)
+            if (pending & (1u << i)) finish(i, false);
+        schedule_next();
+        break;
+    case ARRAY_HOLDOFF:
+        // Algum sensor do grupo ainda segura o eco sem objeto: espera baixar
+        if (gpio_get_all() & group_echo_mask[group])
+            sonar_set_alarm(alarm, time_us_64() + SONAR_GAP_US);
+        else
+            trigger_group();
+        break;
+    default:
+        break;
+    }
+}
+
+static void echo_irq(void) {
+    // Um timestamp para todas as bordas pendentes nesta entrada da IRQ
+    uint64_t now = time_us_64();
+    for (uint i = 0; i < count; i++) {
+        sensor_t *s = &sensors[i];
+        uint32_t ev = gpio_get_irq_event_mask(s->echo);
+        if (!ev) continue;
+        gpio_acknowledge_irq(s->echo, ev);
+        if (state != ARRAY_MEASURING) continue;
+
+        if ((ev & GPIO_IRQ_EDGE_RISE) && s->state == SONAR_WAIT_RISE) {
+            s->cur.rise_us = now;
+            s->state = SONAR_ECHO;
+        }
+        if ((ev & GPIO_IRQ_EDGE_FALL) && s->state == SONAR_ECHO) {
+            s->cur.fall_us = now;
+            s->cur.echo_us = now - s->cur.rise_us;
+            finish(i, true);
+        }
+    }
+    if (state == ARRAY_MEASURING && !pending) {
+        hardware_alarm_cancel(alarm);
+        schedule_next();
+    }
+}
+
+void sonar_array_init(const sonar_pins_t *pins, uint n, uint groups, sonar_array_cb_t cb) {
+    if (n > SONAR_ARRAY_MAX) n = SONAR_ARRAY_MAX;
+    if (groups < 1) groups = 1;
+    if (groups > n) groups = n;
+    count = n;
+    n_groups = groups;
+    done_cb = cb;
+
+    uint32_t echo_mask = 0;
+    for (uint i = 0; i < n; i++) {
+        sensor_t *s = &sensors[i];
+        s->trig = pins[i].trig_pin;
+        s->echo = pins[i].echo_pin;
+        s->state = SONAR_IDLE;
+        s->fresh = false;
+
+        gpio_init(s->trig);
+        gpio_set_dir(s->trig, GPIO_OUT);
+        gpio_put(s->trig, 0);
+        gpio_init(s->echo);
+        gpio_set_dir(s->echo, GPIO_IN);
+
+        group_trig_mask[i % groups] |= 1u << s->trig;
+        group_echo_mask[i % groups] |= 1u << s->echo;
+        echo_mask |= 1u << s->echo;
+    }
+
+    alarm = hardware_alarm_claim_unused(true);
+    hardware_alarm_set_callback(alarm, alarm_cb);
+    hrtimer_init(&pulse, "ArrayTrig", SONAR_TRIG_US, false, NULL, pulse_end, HRTIMER_ISR);
+
+    // Um handler para todos os pinos de eco da tabela
+    gpio_add_raw_irq_handler_masked(echo_mask, echo_irq);
+    for (uint i = 0; i < n; i++)
+        gpio_set_irq_enabled(sensors[i].echo, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true);
+    irq_set_enabled(IO_IRQ_BANK0, true);
+}
+
+void sonar_array_start(void) {
+    uint32_t irq = save_and_disable_interrupts();
+    if (state == ARRAY_IDLE) {
+        // schedule_next avança para o grupo 0
+        group = n_groups - 1;
+        schedule_next();
+    }
+    restore_interrupts(irq);
+}
+
+void sonar_array_stop(void) {
+    uint32_t irq = save_and_disable_interrupts();
+    hardware_alarm_cancel(alarm);
+    hrtimer_stop(&pulse);
+    pulse_end(&pulse);
+    for (uint i = 0; i < count; i++) sensors[i].state = SONAR_IDLE;
+    pending = 0;
+    state = ARRAY_IDLE;
+    restore_interrupts(irq);
+}
+
+void sonar_array_set_period_ms(uint32_t ms) {
+    uint32_t us = ms * 1000;
+    period_us = us < SONAR_MIN_PERIOD_US ? SONAR_MIN_PERIOD_US : us;
+}
+
+uint sonar_array_count(void) {
+    return count;
+}
+
+bool sonar_array_poll(uint idx, sonar_reading_t *r) {
+    if (idx >= count) return false;
+    sensor_t *s = &sensors[idx];
+    uint32_t irq = save_and_disable_interrupts();
+    bool got = s->fresh;
+    if (got) {
+        *r = s->last;
+        s->fresh = false;
+    }
+    restore_interrupts(irq);
+    return got;
+}
+
+uint32_t sonar_array_readings(void) {
+    return readings;
+}
@@ -0,0 +1,39 @@
+#ifndef SONAR_ARRAY_H
+#define SONAR_ARRAY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+
+#include "sonar.h"
+
+#define SONAR_ARRAY_MAX 8
+
+// Pinos de um sensor da tabela
+typedef struct {
+    uint trig_pin;
+    uint echo_pin;
+} sonar_pins_t;
+
+// Chamado na IRQ ao fim de cada medição de cada sensor
+typedef void (*sonar_array_cb_t)(uint idx, const sonar_reading_t *r);
+
+// Vários HC-SR04 numa IRQ de GPIO compartilhada e um único alarme.
+// Os sensores disparam em grupos: o sensor i entra no grupo i % groups,
+// então vizinhos na tabela nunca pingam juntos e cada grupo mede em
+// paralelo. A tabela vai na ordem física dos sensores; groups = 2 para
+// uma fileira, 3 para um anel com número ímpar de sensores.
+void sonar_array_init(const sonar_pins_t *pins, uint n, uint groups, sonar_array_cb_t cb);
+// Roda os grupos em sequência: o próximo grupo sai logo que o anterior
+// termina (eco ou timeout) mais a pausa de reverberação
+void sonar_array_start(void);
+void sonar_array_stop(void);
+// Período mínimo entre dois pings do mesmo sensor (mínimo de 25 ms)
+void sonar_array_set_period_ms(uint32_t ms);
+uint sonar_array_count(void);
+// Copia a última leitura do sensor idx; true só se ela ainda não tinha sido lida
+bool sonar_array_poll(uint idx, sonar_reading_t *r);
+// Medições terminadas desde o init, somando todos os sensores
+uint32_t sonar_array_readings(void);
+
+#endif
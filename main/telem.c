@@ -0,0 +1,62 @@
+#include "telem.h"
+
+#include <stdio.h>
+
+#include "task.h"
+
+// A linha mais longa é a de distância, com quatro números de 32 bits
+#define TELEM_LINHA 128
+
+void telem_send(telem_t *t, telem_tipo_t tipo, uint8_t sensor, int32_t a, int32_t b,
+                int32_t c, int32_t d) {
+    telem_msg_t m = {tipo, sensor, {a, b, c, d}};
+    xQueueSend(t->fila, &m, 0);
+}
+
+static void escrever(const telem_t *t, const telem_msg_t *m) {
+    char linha[TELEM_LINHA];
+    switch (m->tipo) {
+    case TELEM_DISTANCIA:
+        snprintf(linha, sizeof(linha), "Distância %u: %ld mm a %ld° (filtrada %ld mm, %ld mm/s)\n",
+                 m->sensor, (long)m->v[0], (long)(m->v[1] / 1000), (long)m->v[2], (long)m->v[3]);
+        break;
+    case TELEM_BLOQUEIO:
+        snprintf(linha, sizeof(linha), "Sonar %u: %ld pings/s, latência %ld ms (média %ld, máx %ld)\n",
+                 m->sensor, (long)m->v[0], (long)m->v[1], (long)m->v[2], (long)m->v[3]);
+        break;
+    case TELEM_GRAVANDO:
+        t->io->saida(m->sensor ? "Objeto detectado! Gravando...\n" : "Som detectado! Gravando...\n");
+        snprintf(linha, sizeof(linha), "VAD: %ld us/bloco (max %ld)\n", (long)m->v[0],
+                 (long)m->v[1]);
+        break;
+    case TELEM_TOCANDO:
+        snprintf(linha, sizeof(linha), "Reproduzindo...\n");
+        break;
+    default:
+        return;
+    }
+    t->io->saida(linha);
+}
+
+void telem_task(void *p) {
+    telem_t *t = p;
+    const telem_io_t *io = t->io;
+    if (io->iniciar) io->iniciar();
+    TickType_t ultima_carga = xTaskGetTickCount();
+
+    while (true) {
+        telem_msg_t m;
+        if (xQueueReceive(t->fila, &m, pdMS_TO_TICKS(t->espera_ms)) == pdTRUE) escrever(t, &m);
+        if (io->carga && xTaskGetTickCount() - ultima_carga >= pdMS_TO_TICKS(t->carga_ms)) {
+            ultima_carga = xTaskGetTickCount();
+            telem_carga_t c;
+            io->carga(&c);
+            char linha[TELEM_LINHA];
+            snprintf(linha, sizeof(linha), "CPU: %lu.%lu%% ociosa, %lu sonos, %lu ticks pulados\n",
+                     (unsigned long)(c.ociosa_permille / 10), (unsigned long)(c.ociosa_permille % 10),
+                     (unsigned long)c.sonos, (unsigned long)c.ticks_pulados);
+            io->saida(linha);
+        }
+        if (io->volta) io->volta();
+    }
+}
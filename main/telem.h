@@ -0,0 +1,58 @@
+#ifndef TELEM_H
+#define TELEM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "FreeRTOS.h"
+#include "queue.h"
+
+typedef enum {
+    TELEM_DISTANCIA,  // v: mm bruto, mdeg, mm filtrado, mm/s
+    TELEM_BLOQUEIO,   // v: pings/s, latência última, média, máxima
+    TELEM_GRAVANDO,   // sensor: 1 objeto, 0 som; v: custo médio e máximo do VAD
+    TELEM_TOCANDO,
+} telem_tipo_t;
+
+typedef struct {
+    telem_tipo_t tipo;
+    uint8_t sensor;
+    int32_t v[4];
+} telem_msg_t;
+
+// Relatório periódico de carga da CPU
+typedef struct {
+    uint32_t ociosa_permille;
+    uint32_t sonos;
+    uint32_t ticks_pulados;
+} telem_carga_t;
+
+// O que a tarefa de telemetria usa do resto. No firmware é o stdio, os
+// run-time stats e o radar; no teste de host, linhas guardadas para
+// conferir. Só saida é obrigatório.
+typedef struct {
+    // Antes do laço, já dentro da tarefa
+    void (*iniciar)(void);
+    // Uma linha pronta, com o '\n'
+    void (*saida)(const char *linha);
+    void (*carga)(telem_carga_t *c);
+    // A cada volta, depois da fila: o radar manda quadros prontos
+    void (*volta)(void);
+} telem_io_t;
+
+// Configuração da tarefa; struct do chamador
+typedef struct {
+    const telem_io_t *io;
+    QueueHandle_t fila;     // telem_msg_t
+    uint32_t espera_ms;     // prazo da fila: o ritmo de volta e carga
+    uint32_t carga_ms;      // intervalo do relatório de carga
+} telem_t;
+
+// Quem publica nunca espera: com a fila cheia a mensagem se perde
+void telem_send(telem_t *t, telem_tipo_t tipo, uint8_t sensor, int32_t a, int32_t b,
+                int32_t c, int32_t d);
+
+// Formata as mensagens da fila e o relatório de carga. p é o telem_t.
+void telem_task(void *p);
+
+#endif
@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+
+# Reads the radar frames streamed by the Pico and plots each sweep
+
+# Install dependencies:
+# python3 -m pip install pyserial matplotlib
+
+# Usage: python3 radar.py <port>
+# eg. python3 radar.py /dev/ttyACM0
+
+# Frame line: "R <seq> <dir> <pings> <bins>", 4 hex digits per 2 deg bin.
+# 0000 = bin not pinged, ffff = pinged with no echo, else distance in mm.
+
+import math
+import serial
+import sys
+import matplotlib.pyplot as plt
+import matplotlib.animation as animation
+
+BIN_DEG = 2
+UNSEEN = 0x0000
+FREE = 0xffff
+MAX_MM = 4000
+
+plt.rcParams['toolbar'] = 'None'
+
+
+def parse(line):
+    parts = line.split()
+    if len(parts) != 5 or parts[0] != 'R':
+        return None
+    bins = parts[4]
+    mm = [int(bins[i:i + 4], 16) for i in range(0, len(bins), 4)]
+    return int(parts[1]), mm
+
+
+def frames():
+    while True:
+        line = ser.readline().decode(errors='ignore').strip()
+        frame = parse(line)
+        if frame:
+            yield frame
+
+
+def update(frame):
+    seq, mm = frame
+    theta, r = [], []
+    for i, v in enumerate(mm):
+        if v in (UNSEEN, FREE):
+            continue
+        theta.append(math.radians(i * BIN_DEG + BIN_DEG / 2))
+        r.append(v)
+    points.set_offsets(list(zip(theta, r)) or [(0, 0)])
+    ax.set_title("Sweep %d" % seq)
+    return points,
+
+
+if len(sys.argv) < 2:
+    raise Exception("Ruh roh..no port specified!")
+
+ser = serial.Serial(sys.argv[1], 115200, timeout=1)
+
+fig = plt.figure()
+ax = fig.add_subplot(projection='polar')
+ax.set_thetamin(0)
+ax.set_thetamax(180)
+ax.set_ylim(0, MAX_MM)
+points = ax.scatter([], [], s=12)
+
+ani = animation.FuncAnimation(fig, update, frames, interval=1,
+                              blit=False, cache_frame_data=False)
+
+fig.canvas.manager.set_window_title('Ultrasonic radar')
+plt.show()
@@ -0,0 +1,34 @@
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <stdio.h>
+
+// Asserções mínimas dos testes de host: contam falhas e seguem, para um
+// erro não esconder os outros. main() devolve check_result().
+static int check_failures;
+
+#define CHECK(cond)                                                          \
+    do {                                                                     \
+        if (!(cond)) {                                                       \
+            fprintf(stderr, "%s:%d: falhou: %s\n", __FILE__, __LINE__, #cond); \
+            check_failures++;                                                \
+        }                                                                    \
+    } while (0)
+
+#define CHECK_EQ(a, b)                                                       \
+    do {                                                                     \
+        long long _a = (long long)(a), _b = (long long)(b);                  \
+        if (_a != _b) {                                                      \
+            fprintf(stderr, "%s:%d: falhou: %s == %s (%lld != %lld)\n",      \
+                    __FILE__, __LINE__, #a, #b, _a, _b);                     \
+            check_failures++;                                                \
+        }                                                                    \
+    } while (0)
+
+static inline int check_result(const char *name) {
+    if (check_failures) fprintf(stderr, "%s: %d falha(s)\n", name, check_failures);
+    else printf("%s: ok\n", name);
+    return check_failures != 0;
+}
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef MOCK_HARDWARE_ADC_H
+#define MOCK_HARDWARE_ADC_H
+
+#include "pico/stdlib.h"
+
+typedef struct {
+    volatile uint32_t fifo;
+} adc_hw_t;
+
+extern adc_hw_t *const adc_hw;
+
+// Estado que os testes conferem
+extern float mock_adc_clkdiv;
+extern bool mock_adc_running;
+extern uint mock_adc_input;
+
+void adc_init(void);
+void adc_select_input(uint input);
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift);
+void adc_set_clkdiv(float clkdiv);
+void adc_run(bool run);
+void adc_fifo_drain(void);
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef MOCK_HARDWARE_DMA_H
+#define MOCK_HARDWARE_DMA_H
+
+#include "pico/stdlib.h"
+
+#define MOCK_DMA_CHANNELS 4
+
+enum dma_channel_transfer_size { DMA_SIZE_8 = 0, DMA_SIZE_16 = 1, DMA_SIZE_32 = 2 };
+
+#define DREQ_ADC 36
+
+typedef struct {
+    uint chain_to;
+    uint dreq;
+    enum dma_channel_transfer_size size;
+    bool read_incr;
+    bool write_incr;
+} dma_channel_config;
+
+// Canal simulado: o teste completa a transferência com mock_dma_complete
+typedef struct {
+    dma_channel_config cfg;
+    void *write_addr;
+    const volatile void *read_addr;
+    uint32_t count;
+    bool busy;
+    bool irq0_enabled;
+    bool irq0_status;
+} mock_dma_channel_t;
+
+extern mock_dma_channel_t mock_dma[MOCK_DMA_CHANNELS];
+
+int dma_claim_unused_channel(bool required);
+dma_channel_config dma_channel_get_default_config(uint ch);
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size);
+void channel_config_set_read_increment(dma_channel_config *c, bool incr);
+void channel_config_set_write_increment(dma_channel_config *c, bool incr);
+void channel_config_set_dreq(dma_channel_config *c, uint dreq);
+void channel_config_set_chain_to(dma_channel_config *c, uint chain_to);
+void dma_channel_configure(uint ch, const dma_channel_config *c, volatile void *write_addr,
+                           const volatile void *read_addr, uint32_t count, bool trigger);
+void dma_channel_set_write_addr(uint ch, volatile void *write_addr, bool trigger);
+void dma_channel_transfer_to_buffer_now(uint ch, volatile void *dst, uint32_t count);
+void dma_channel_start(uint ch);
+void dma_channel_abort(uint ch);
+void dma_channel_set_irq0_enabled(uint ch, bool enabled);
+bool dma_channel_get_irq0_status(uint ch);
+void dma_channel_acknowledge_irq0(uint ch);
+
+// Termina a transferência do canal ch com as amostras de next_sample,
+// dispara o chain e levanta a IRQ, na ordem do hardware
+void mock_dma_complete(uint ch, uint16_t (*next_sample)(void));
+
+#endif
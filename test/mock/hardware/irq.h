@@ -0,0 +1,16 @@
+#ifndef MOCK_HARDWARE_IRQ_H
+#define MOCK_HARDWARE_IRQ_H
+
+#include "pico/stdlib.h"
+
+typedef void (*irq_handler_t)(void);
+
+#define DMA_IRQ_0 11
+#define PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY 0x80
+
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t order_priority);
+void irq_set_enabled(uint num, bool enabled);
+// Chama os handlers registrados na linha, como o NVIC faria
+void mock_irq_fire(uint num);
+
+#endif
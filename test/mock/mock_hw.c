@@ -0,0 +1,149 @@
+#include <string.h>
+
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+
+uint64_t mock_time_us;
+
+// === ADC ===
+static adc_hw_t adc_regs;
+adc_hw_t *const adc_hw = &adc_regs;
+float mock_adc_clkdiv;
+bool mock_adc_running;
+uint mock_adc_input;
+
+void adc_init(void) {}
+
+void adc_select_input(uint input) {
+    mock_adc_input = input;
+}
+
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo,
+                    bool byte_shift) {
+    (void)en, (void)dreq_en, (void)dreq_thresh, (void)err_in_fifo, (void)byte_shift;
+}
+
+void adc_set_clkdiv(float clkdiv) {
+    mock_adc_clkdiv = clkdiv;
+}
+
+void adc_run(bool run) {
+    mock_adc_running = run;
+}
+
+void adc_fifo_drain(void) {}
+
+// === IRQ ===
+#define MOCK_IRQ_HANDLERS 4
+static struct {
+    uint num;
+    irq_handler_t handler;
+} handlers[MOCK_IRQ_HANDLERS];
+static uint n_handlers;
+
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t order_priority) {
+    (void)order_priority;
+    if (n_handlers < MOCK_IRQ_HANDLERS) {
+        handlers[n_handlers].num = num;
+        handlers[n_handlers].handler = handler;
+        n_handlers++;
+    }
+}
+
+void irq_set_enabled(uint num, bool enabled) {
+    (void)num, (void)enabled;
+}
+
+void mock_irq_fire(uint num) {
+    for (uint i = 0; i < n_handlers; i++)
+        if (handlers[i].num == num) handlers[i].handler();
+}
+
+// === DMA ===
+mock_dma_channel_t mock_dma[MOCK_DMA_CHANNELS];
+static uint n_claimed;
+
+int dma_claim_unused_channel(bool required) {
+    (void)required;
+    return n_claimed < MOCK_DMA_CHANNELS ? (int)n_claimed++ : -1;
+}
+
+dma_channel_config dma_channel_get_default_config(uint ch) {
+    dma_channel_config c = {.chain_to = ch, .size = DMA_SIZE_32, .read_incr = true};
+    return c;
+}
+
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size) {
+    c->size = size;
+}
+
+void channel_config_set_read_increment(dma_channel_config *c, bool incr) {
+    c->read_incr = incr;
+}
+
+void channel_config_set_write_increment(dma_channel_config *c, bool incr) {
+    c->write_incr = incr;
+}
+
+void channel_config_set_dreq(dma_channel_config *c, uint dreq) {
+    c->dreq = dreq;
+}
+
+void channel_config_set_chain_to(dma_channel_config *c, uint chain_to) {
+    c->chain_to = chain_to;
+}
+
+void dma_channel_configure(uint ch, const dma_channel_config *c, volatile void *write_addr,
+                           const volatile void *read_addr, uint32_t count, bool trigger) {
+    mock_dma[ch].cfg = *c;
+    mock_dma[ch].write_addr = (void *)write_addr;
+    mock_dma[ch].read_addr = read_addr;
+    mock_dma[ch].count = count;
+    mock_dma[ch].busy = trigger;
+}
+
+void dma_channel_set_write_addr(uint ch, volatile void *write_addr, bool trigger) {
+    mock_dma[ch].write_addr = (void *)write_addr;
+    if (trigger) mock_dma[ch].busy = true;
+}
+
+void dma_channel_transfer_to_buffer_now(uint ch, volatile void *dst, uint32_t count) {
+    mock_dma[ch].write_addr = (void *)dst;
+    mock_dma[ch].count = count;
+    mock_dma[ch].busy = true;
+}
+
+void dma_channel_start(uint ch) {
+    mock_dma[ch].busy = true;
+}
+
+void dma_channel_abort(uint ch) {
+    mock_dma[ch].busy = false;
+}
+
+void dma_channel_set_irq0_enabled(uint ch, bool enabled) {
+    mock_dma[ch].irq0_enabled = enabled;
+}
+
+bool dma_channel_get_irq0_status(uint ch) {
+    return mock_dma[ch].irq0_status;
+}
+
+void dma_channel_acknowledge_irq0(uint ch) {
+    mock_dma[ch].irq0_status = false;
+}
+
+void mock_dma_complete(uint ch, uint16_t (*next_sample)(void)) {
+    mock_dma_channel_t *c = &mock_dma[ch];
+    uint16_t *dst = c->write_addr;
+    for (uint32_t i = 0; i < c->count; i++) dst[i] = next_sample();
+    c->busy = false;
+    // O hardware avança o endereço de escrita até o fim do bloco
+    c->write_addr = dst + c->count;
+    if (c->cfg.chain_to != ch) mock_dma[c->cfg.chain_to].busy = true;
+    if (c->irq0_enabled) {
+        c->irq0_status = true;
+        mock_irq_fire(DMA_IRQ_0);
+    }
+}
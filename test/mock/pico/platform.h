@@ -0,0 +1,9 @@
+#ifndef MOCK_PICO_PLATFORM_H
+#define MOCK_PICO_PLATFORM_H
+
+// Atributos de seção do SDK não fazem nada no host
+#define __not_in_flash_func(f) f
+#define __time_critical_func(f) f
+#define __noinline __attribute__((noinline))
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef MOCK_PICO_STDLIB_H
+#define MOCK_PICO_STDLIB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "pico/platform.h"
+
+typedef unsigned int uint;
+
+// Relógio do host: os testes avançam mock_time_us à mão
+extern uint64_t mock_time_us;
+
+static inline uint64_t time_us_64(void) {
+    return mock_time_us;
+}
+
+static inline uint32_t time_us_32(void) {
+    return (uint32_t)mock_time_us;
+}
+
+#endif
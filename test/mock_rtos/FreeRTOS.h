@@ -0,0 +1,16 @@
+#ifndef MOCK_FREERTOS_H
+#define MOCK_FREERTOS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Só o que os drivers usam da IRQ; para o grafo de tarefas o teste de
+// host usa o kernel de verdade no port POSIX
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define portYIELD_FROM_ISR(x) ((void)(x))
+
+#endif
@@ -0,0 +1,52 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "stream_buffer.h"
+
+struct mock_stream {
+    uint8_t *buf;
+    size_t size;
+    size_t head;
+    size_t len;
+};
+
+StreamBufferHandle_t xStreamBufferCreate(size_t size, size_t trigger) {
+    (void)trigger;
+    StreamBufferHandle_t sb = calloc(1, sizeof(*sb));
+    sb->buf = malloc(size);
+    sb->size = size;
+    return sb;
+}
+
+void vStreamBufferDelete(StreamBufferHandle_t sb) {
+    free(sb->buf);
+    free(sb);
+}
+
+size_t xStreamBufferSpacesAvailable(StreamBufferHandle_t sb) {
+    return sb->size - sb->len;
+}
+
+size_t xStreamBufferBytesAvailable(StreamBufferHandle_t sb) {
+    return sb->len;
+}
+
+size_t xStreamBufferSendFromISR(StreamBufferHandle_t sb, const void *data, size_t len,
+                                BaseType_t *woken) {
+    const uint8_t *p = data;
+    if (len > sb->size - sb->len) len = sb->size - sb->len;
+    for (size_t i = 0; i < len; i++) sb->buf[(sb->head + sb->len + i) % sb->size] = p[i];
+    sb->len += len;
+    if (len && woken) *woken = pdTRUE;
+    return len;
+}
+
+size_t xStreamBufferReceive(StreamBufferHandle_t sb, void *data, size_t len, uint32_t ticks) {
+    (void)ticks;
+    uint8_t *p = data;
+    if (len > sb->len) len = sb->len;
+    for (size_t i = 0; i < len; i++) p[i] = sb->buf[(sb->head + i) % sb->size];
+    sb->head = (sb->head + len) % sb->size;
+    sb->len -= len;
+    return len;
+}
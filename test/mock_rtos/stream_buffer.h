@@ -0,0 +1,18 @@
+#ifndef MOCK_STREAM_BUFFER_H
+#define MOCK_STREAM_BUFFER_H
+
+#include "FreeRTOS.h"
+
+// Stream buffer de bytes sem bloqueio, suficiente para o lado da IRQ
+typedef struct mock_stream *StreamBufferHandle_t;
+
+StreamBufferHandle_t xStreamBufferCreate(size_t size, size_t trigger);
+void vStreamBufferDelete(StreamBufferHandle_t sb);
+size_t xStreamBufferSpacesAvailable(StreamBufferHandle_t sb);
+size_t xStreamBufferBytesAvailable(StreamBufferHandle_t sb);
+size_t xStreamBufferSendFromISR(StreamBufferHandle_t sb, const void *data, size_t len,
+                                BaseType_t *woken);
+// Sem espera: devolve o que houver até len
+size_t xStreamBufferReceive(StreamBufferHandle_t sb, void *data, size_t len, uint32_t ticks);
+
+#endif
@@ -0,0 +1,150 @@
+// Captura com o ADC e o DMA simulados: ritmo pelo clkdiv, alternância
+// do ping-pong, rearme dos canais, descarte com o stream cheio e a
+// sobreamostragem com decimação.
+
+#include <string.h>
+
+#include "check.h"
+#include "audio_capture.h"
+#include "audio_decim.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+
+#define RATE 8000
+
+// Rampa de 12 bits: cada amostra diz sua posição no fluxo
+static uint32_t seq;
+static uint16_t rampa(void) {
+    return seq++ & 0xfff;
+}
+
+static uint16_t nivel;
+static uint16_t constante(void) {
+    return nivel;
+}
+
+// Canal que o DMA está enchendo
+static int ocupado(void) {
+    for (int i = 0; i < MOCK_DMA_CHANNELS; i++)
+        if (mock_dma[i].busy) return i;
+    return -1;
+}
+
+static bool terminou;
+static void fim_captura(void) {
+    terminou = true;
+}
+
+static void test_ritmo(void) {
+    // Período = (1 + div) ciclos de 48 MHz
+    CHECK(mock_adc_clkdiv > 5998.9f && mock_adc_clkdiv < 5999.1f);
+    CHECK_EQ(mock_adc_input, 1);
+}
+
+static void test_ping_pong(void) {
+    StreamBufferHandle_t sb = xStreamBufferCreate(4 * AUDIO_BLOCK_BYTES, AUDIO_BLOCK_BYTES);
+    audio_capture_set_oversampling(false);
+    audio_capture_stream_start(sb);
+    CHECK(mock_adc_running);
+    CHECK(mock_adc_clkdiv > 5998.9f && mock_adc_clkdiv < 5999.1f);
+    CHECK_EQ(ocupado(), 0);
+    void *bloco[2] = {mock_dma[0].write_addr, mock_dma[1].write_addr};
+    CHECK(bloco[0] != bloco[1]);
+
+    seq = 0;
+    for (int n = 0; n < 64; n++) {
+        int ch = ocupado();
+        // Alterna os canais e cada um escreve sempre no próprio bloco
+        CHECK_EQ(ch, n % 2);
+        CHECK(mock_dma[ch].write_addr == bloco[ch]);
+        mock_dma_complete(ch, rampa);
+
+        uint16_t out[AUDIO_BLOCK_SAMPLES];
+        CHECK_EQ(xStreamBufferReceive(sb, out, sizeof(out), 0), sizeof(out));
+        for (int i = 0; i < AUDIO_BLOCK_SAMPLES; i++)
+            CHECK_EQ(out[i], (n * AUDIO_BLOCK_SAMPLES + i) & 0xfff);
+    }
+    CHECK_EQ(audio_capture_dropped(), 0);
+
+    audio_capture_stop();
+    CHECK(!mock_adc_running);
+    CHECK_EQ(ocupado(), -1);
+    vStreamBufferDelete(sb);
+}
+
+static void test_descarte(void) {
+    // Cabe um bloco e meio: o segundo bloco não entra pela metade
+    StreamBufferHandle_t sb = xStreamBufferCreate(AUDIO_BLOCK_BYTES * 3 / 2, AUDIO_BLOCK_BYTES);
+    uint32_t antes = audio_capture_dropped();
+    audio_capture_stream_start(sb);
+
+    seq = 0;
+    for (int n = 0; n < 5; n++) mock_dma_complete(ocupado(), rampa);
+    CHECK_EQ(xStreamBufferBytesAvailable(sb), AUDIO_BLOCK_BYTES);
+    CHECK_EQ(audio_capture_dropped() - antes, 4 * AUDIO_BLOCK_SAMPLES);
+
+    // Consumido o atraso, o próximo bloco volta a entrar inteiro
+    uint16_t out[AUDIO_BLOCK_SAMPLES];
+    xStreamBufferReceive(sb, out, sizeof(out), 0);
+    CHECK_EQ(out[0], 0);
+    mock_dma_complete(ocupado(), rampa);
+    CHECK_EQ(xStreamBufferReceive(sb, out, sizeof(out), 0), sizeof(out));
+    CHECK_EQ(out[0], (5 * AUDIO_BLOCK_SAMPLES) & 0xfff);
+
+    audio_capture_stop();
+    vStreamBufferDelete(sb);
+}
+
+static void test_sobreamostragem(void) {
+    StreamBufferHandle_t sb = xStreamBufferCreate(4 * AUDIO_BLOCK_BYTES, AUDIO_BLOCK_BYTES);
+    audio_capture_set_oversampling(true);
+    audio_capture_stream_start(sb);
+    // 64 kHz no ADC
+    CHECK(mock_adc_clkdiv > 748.9f && mock_adc_clkdiv < 749.1f);
+
+    // DECIM_R blocos brutos rendem um bloco no stream
+    nivel = 3000;
+    for (int n = 0; n < DECIM_R - 1; n++) mock_dma_complete(ocupado(), constante);
+    CHECK_EQ(xStreamBufferBytesAvailable(sb), 0);
+    mock_dma_complete(ocupado(), constante);
+    CHECK_EQ(xStreamBufferBytesAvailable(sb), AUDIO_BLOCK_BYTES);
+
+    // Passado o transitório do CIC + FIR, o DC passa sem ganho
+    uint16_t out[AUDIO_BLOCK_SAMPLES];
+    xStreamBufferReceive(sb, out, sizeof(out), 0);
+    for (int i = 16; i < AUDIO_BLOCK_SAMPLES; i++) CHECK(out[i] >= 2999 && out[i] <= 3001);
+
+    audio_capture_stop();
+    audio_capture_set_oversampling(false);
+    vStreamBufferDelete(sb);
+}
+
+static void test_captura_unica(void) {
+    static uint16_t buf[1000];
+    terminou = false;
+    audio_capture_start(buf, 1000, fim_captura);
+    CHECK(audio_capture_busy());
+    CHECK(mock_adc_clkdiv > 5998.9f && mock_adc_clkdiv < 5999.1f);
+    CHECK(mock_dma[0].write_addr == buf);
+    CHECK_EQ(mock_dma[0].count, 1000);
+    // Sem chain: só o canal 0 roda
+    CHECK_EQ(mock_dma[0].cfg.chain_to, 0);
+
+    seq = 0;
+    mock_dma_complete(0, rampa);
+    CHECK(terminou);
+    CHECK(!audio_capture_busy());
+    CHECK(!mock_adc_running);
+    CHECK_EQ(buf[999], 999);
+    CHECK_EQ(ocupado(), -1);
+}
+
+int main(void) {
+    audio_capture_init(1, RATE);
+    test_ritmo();
+    test_ping_pong();
+    test_descarte();
+    test_sobreamostragem();
+    test_captura_unica();
+    return check_result("audio_capture");
+}
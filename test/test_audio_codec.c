@@ -0,0 +1,171 @@
+// Vetores de ida e volta dos codecs: IMA-ADPCM contra uma referência
+// escrita a partir da especificação (IMA/DVI) e µ-law contra os valores
+// da G.711.
+
+#include <math.h>
+#include <string.h>
+
+#include "check.h"
+#include "audio_codec.h"
+
+#define N 512
+
+// Codificador IMA de referência: forma do padrão, com vpdiff somado
+// passo a passo em vez da reconstrução compartilhada do módulo
+static const int ima_index[16] = {-1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8};
+static const int ima_step[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+    253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+    1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+    3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442,
+    11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794,
+    32767};
+
+static uint8_t ref_encode(int *pred, int *index, int16_t s) {
+    int step = ima_step[*index];
+    int diff = s - *pred;
+    uint8_t code = 0;
+    if (diff < 0) {
+        code = 8;
+        diff = -diff;
+    }
+    int vpdiff = step >> 3;
+    if (diff >= step) {
+        code |= 4;
+        diff -= step;
+        vpdiff += step;
+    }
+    step >>= 1;
+    if (diff >= step) {
+        code |= 2;
+        diff -= step;
+        vpdiff += step;
+    }
+    step >>= 1;
+    if (diff >= step) {
+        code |= 1;
+        vpdiff += step;
+    }
+    *pred += code & 8 ? -vpdiff : vpdiff;
+    if (*pred > 32767) *pred = 32767;
+    if (*pred < -32768) *pred = -32768;
+    *index += ima_index[code];
+    if (*index < 0) *index = 0;
+    if (*index > 88) *index = 88;
+    return code;
+}
+
+static int16_t in[N];
+
+static void sinal(double freq, double amp) {
+    for (int i = 0; i < N; i++) in[i] = (int16_t)lround(amp * sin(2 * M_PI * freq * i / 8000));
+}
+
+static double snr_db(const int16_t *a, const int16_t *b, int n) {
+    double s = 0, e = 0;
+    for (int i = 0; i < n; i++) {
+        s += (double)a[i] * a[i];
+        e += (double)(a[i] - b[i]) * (a[i] - b[i]);
+    }
+    return 10 * log10(s / (e + 1e-9));
+}
+
+static void test_adpcm_referencia(void) {
+    // Degrau, rampa e seno cheio: os códigos batem com a referência
+    for (int i = 0; i < N; i++) in[i] = i < 64 ? 0 : i < 128 ? 20000 : (i - 256) * 120;
+    for (int k = 0; k < 2; k++) {
+        if (k) sinal(1000, 32000);
+        uint8_t out[N / 2];
+        adpcm_state_t st = {0, 0};
+        adpcm_encode(&st, in, N, out);
+        int pred = 0, index = 0;
+        for (int i = 0; i < N; i++) {
+            uint8_t b = out[i / 2];
+            uint8_t code = i & 1 ? b >> 4 : b & 0x0f;
+            CHECK_EQ(code, ref_encode(&pred, &index, in[i]));
+        }
+        CHECK_EQ(st.predictor, pred);
+        CHECK_EQ(st.index, index);
+    }
+}
+
+static void test_adpcm_ida_e_volta(void) {
+    uint8_t enc[N / 2];
+    int16_t dec[N];
+    // O ADPCM de 4 bits perde SNR quando o sinal muda rápido entre amostras
+    double freqs[] = {300, 1000, 3000};
+    double min_db[] = {30, 18, 12};
+    for (int k = 0; k < 3; k++) {
+        sinal(freqs[k], 8000);
+        adpcm_state_t e = {0, 0}, d = {0, 0};
+        adpcm_encode(&e, in, N, enc);
+        adpcm_decode(&d, enc, N, dec);
+        // O decodificador termina no mesmo estado do codificador
+        CHECK_EQ(d.predictor, e.predictor);
+        CHECK_EQ(d.index, e.index);
+        // Descontada a adaptação inicial do passo
+        CHECK(snr_db(in + 64, dec + 64, N - 64) > min_db[k]);
+    }
+}
+
+static void test_adpcm_blocos(void) {
+    // Dois blocos seguidos formam o mesmo fluxo que um só, inclusive
+    // com número ímpar de amostras no último
+    sinal(700, 12000);
+    uint8_t um[N / 2], dois[N / 2];
+    adpcm_state_t a = {0, 0}, b = {0, 0};
+    adpcm_encode(&a, in, 301, um);
+    adpcm_encode(&b, in, 200, dois);
+    adpcm_encode(&b, in + 200, 101, dois + 100);
+    CHECK(memcmp(um, dois, 151) == 0);
+    CHECK_EQ(a.predictor, b.predictor);
+
+    int16_t dec[N];
+    adpcm_state_t d = {0, 0};
+    adpcm_decode(&d, um, 301, dec);
+    adpcm_state_t n = {0, 0};
+    for (int i = 0; i < 301; i++) {
+        uint8_t byte = um[i / 2];
+        CHECK_EQ(adpcm_decode_nibble(&n, i & 1 ? byte >> 4 : byte), dec[i]);
+    }
+}
+
+static void test_ulaw_g711(void) {
+    CHECK_EQ(ulaw_encode(0), 0xff);
+    CHECK_EQ(ulaw_encode(32767), 0x80);
+    CHECK_EQ(ulaw_encode(-32768), 0x00);
+    CHECK_EQ(ulaw_encode(-1), 0x7f);
+    CHECK_EQ(ulaw_decode(0xff), 0);
+    CHECK_EQ(ulaw_decode(0x80), 32124);
+    CHECK_EQ(ulaw_decode(0x00), -32124);
+    CHECK_EQ(ulaw_decode(0xf0), 120);   // segmento 0, mantissa 15
+}
+
+static void test_ulaw_ida_e_volta(void) {
+    // Todo código volta a si mesmo (menos o zero negativo, 0x7f -> 0xff)
+    for (int u = 0; u < 256; u++) {
+        if (u == 0x7f) continue;
+        CHECK_EQ(ulaw_encode(ulaw_decode(u)), u);
+    }
+    // Erro de quantização dentro de meio degrau do segmento
+    for (int32_t x = -32768; x <= 32767; x += 7) {
+        int32_t y = ulaw_decode(ulaw_encode(x));
+        int32_t mag = x < 0 ? -x : x;
+        if (mag > 32635) mag = 32635;
+        int32_t degrau = 8;
+        while (degrau < 1024 && mag + 132 >= 16 * degrau * 2) degrau *= 2;
+        int32_t erro = y - (x < 0 ? -mag : mag);
+        if (erro < 0) erro = -erro;
+        CHECK(erro <= degrau);
+    }
+}
+
+int main(void) {
+    test_adpcm_referencia();
+    test_adpcm_ida_e_volta();
+    test_adpcm_blocos();
+    test_ulaw_g711();
+    test_ulaw_ida_e_volta();
+    return check_result("audio_codec");
+}
@@ -0,0 +1,76 @@
+// Resposta do decimador 64 kHz -> 8 kHz: ganho DC, ondulação na banda
+// de voz e rejeição do que dobraria para dentro dela.
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "check.h"
+#include "audio_decim.h"
+
+#define IN_RATE 64000.0
+#define OUT 4096
+#define SETTLE 64
+#define AMP 1800.0
+
+static uint16_t in[OUT * DECIM_R];
+static uint16_t out[OUT];
+
+// Ganho em dB de um seno de f Hz na entrada, medido pelo RMS da saída
+static double ganho_db(double f) {
+    audio_decim_t d;
+    audio_decim_reset(&d);
+    for (int i = 0; i < OUT * DECIM_R; i++)
+        in[i] = (uint16_t)lround(2048 + AMP * sin(2 * M_PI * f * i / IN_RATE));
+    audio_decim_process(&d, in, OUT * DECIM_R, out);
+    double s = 0;
+    for (int i = SETTLE; i < OUT; i++) s += (out[i] - 2048.0) * (out[i] - 2048.0);
+    double rms = sqrt(s / (OUT - SETTLE));
+    return 20 * log10(rms / (AMP / sqrt(2)) + 1e-9);
+}
+
+static void test_dc(void) {
+    uint16_t niveis[] = {0, 1, 1000, 2048, 3000, 4095};
+    for (int k = 0; k < 6; k++) {
+        audio_decim_t d;
+        audio_decim_reset(&d);
+        for (int i = 0; i < OUT * DECIM_R; i++) in[i] = niveis[k];
+        audio_decim_process(&d, in, OUT * DECIM_R, out);
+        for (int i = SETTLE; i < OUT; i++) CHECK(abs(out[i] - niveis[k]) <= 1);
+    }
+}
+
+static void test_integradores(void) {
+    // Os integradores dão a volta em 32 bits muitas vezes: o comb cancela
+    audio_decim_t d;
+    audio_decim_reset(&d);
+    for (int i = 0; i < OUT * DECIM_R; i++) in[i] = 4095;
+    for (int rep = 0; rep < 64; rep++) audio_decim_process(&d, in, OUT * DECIM_R, out);
+    CHECK_EQ(out[OUT - 1], 4095);
+}
+
+static void test_banda_passante(void) {
+    // O FIR compensa a queda do CIC até ~3,2 kHz
+    for (double f = 100; f <= 3100; f += 100) {
+        double g = ganho_db(f);
+        CHECK(g > -0.1 && g < 0.1);
+    }
+    CHECK(ganho_db(3600) < -0.5);
+}
+
+static void test_alias(void) {
+    // Tons a até 1 kHz de um múltiplo de 8 kHz dobram para 0..1 kHz
+    for (int k = 1; k <= 3; k++) {
+        for (double df = -1000; df <= 1000; df += 250) {
+            double f = k * 8000 + df;
+            CHECK(ganho_db(f) < -45);
+        }
+    }
+}
+
+int main(void) {
+    test_dc();
+    test_integradores();
+    test_banda_passante();
+    test_alias();
+    return check_result("audio_decim");
+}
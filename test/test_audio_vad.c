@@ -0,0 +1,108 @@
+// Detector de atividade em sinais sintéticos: silêncio, tom, ruído de
+// fundo estável acima do limiar e degrau no ruído.
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "check.h"
+#include "audio_vad.h"
+
+#define N 256
+
+static int16_t buf[N];
+static uint32_t semente = 1;
+
+// Ruído uniforme em ±amp (Q15)
+static void ruido(int amp) {
+    for (int i = 0; i < N; i++) {
+        semente = semente * 1103515245u + 12345u;
+        buf[i] = (int32_t)((semente >> 16) % (2 * amp + 1)) - amp;
+    }
+}
+
+static void tom(double f, int amp, int bloco) {
+    for (int i = 0; i < N; i++)
+        buf[i] = (int16_t)lround(amp * sin(2 * M_PI * f * (bloco * N + i) / 8000));
+}
+
+// Blocos de ruído até o detector desligar; -1 se não desligou
+static int blocos_ate_desligar(audio_vad_t *v, int amp, int max) {
+    for (int b = 0; b < max; b++) {
+        ruido(amp);
+        audio_vad_process(v, buf, N);
+        if (!v->active) return b;
+    }
+    return -1;
+}
+
+static void test_silencio(void) {
+    audio_vad_t v;
+    audio_vad_init(&v);
+    for (int b = 0; b < 200; b++) {
+        ruido(8);
+        audio_vad_process(&v, buf, N);
+        CHECK(!v.active);
+    }
+}
+
+static void test_tom_sobre_silencio(void) {
+    audio_vad_t v;
+    audio_vad_init(&v);
+    for (int b = 0; b < 50; b++) {
+        ruido(8);
+        audio_vad_process(&v, buf, N);
+    }
+    tom(300, 3000, 0);
+    audio_vad_process(&v, buf, N);
+    CHECK(v.active);
+}
+
+static void test_fala_longa(void) {
+    // A subida do piso durante atividade não corta 2 s de som contínuo
+    audio_vad_t v;
+    audio_vad_init(&v);
+    for (int b = 0; b < 62; b++) {
+        tom(300, 3000, b);
+        audio_vad_process(&v, buf, N);
+        CHECK(v.active);
+    }
+}
+
+static void test_fundo_estavel(void) {
+    // Ruído de ±200 com ZCR de voz, acima de 2x o piso inicial: já foi
+    // som para sempre; agora o piso o alcança em poucos segundos
+    audio_vad_t v;
+    audio_vad_init(&v);
+    int b = blocos_ate_desligar(&v, 200, 2000);
+    CHECK(b >= 0 && b < 100);
+    for (int i = 0; i < 500; i++) {
+        ruido(200);
+        audio_vad_process(&v, buf, N);
+        CHECK(!v.active);
+    }
+
+    // Um tom bem acima do fundo continua sendo detectado
+    tom(300, 8000, 0);
+    audio_vad_process(&v, buf, N);
+    CHECK(v.active);
+}
+
+static void test_degrau_de_ruido(void) {
+    audio_vad_t v;
+    audio_vad_init(&v);
+    CHECK(blocos_ate_desligar(&v, 200, 2000) >= 0);
+    // Ruído 10x mais forte: ativo no começo, desliga em menos de ~5 s
+    int b = blocos_ate_desligar(&v, 2000, 2000);
+    CHECK(b > 0 && b < 160);
+    // E, com o fundo de volta ao normal, o piso desce rápido
+    CHECK(blocos_ate_desligar(&v, 200, 50) >= 0);
+}
+
+int main(void) {
+    test_silencio();
+    test_tom_sobre_silencio();
+    test_fala_longa();
+    test_fundo_estavel();
+    test_degrau_de_ruido();
+    return check_result("audio_vad");
+}
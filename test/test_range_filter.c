@@ -0,0 +1,65 @@
+// Reproduz traços de distância no filtro do sonar e confere, linha a
+// linha, a decisão near e a janela da distância filtrada. Os traços e o
+// que se espera de cada um estão em traces/ (gen_traces.py).
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "check.h"
+#include "range_filter.h"
+
+#define ENTRA_MM 100
+#define SAI_MM 120
+
+// "-" = qualquer valor
+static bool campo(const char *s, long *v) {
+    while (*s == ' ') s++;
+    if (*s == '-' && (s[1] == '\0' || s[1] == '\n' || s[1] == ',')) return false;
+    *v = strtol(s, NULL, 10);
+    return true;
+}
+
+static void replay(const char *path) {
+    FILE *f = fopen(path, "r");
+    CHECK(f != NULL);
+    if (!f) return;
+
+    range_filter_t rf;
+    range_filter_init(&rf, ENTRA_MM, SAI_MM);
+    char line[128];
+    int n = 0, erros = check_failures;
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '#') continue;
+        char *col[5];
+        int k = 0;
+        for (char *p = strtok(line, ","); p && k < 5; p = strtok(NULL, ",")) col[k++] = p;
+        if (k != 5) continue;
+        n++;
+
+        long t_ms = strtol(col[0], NULL, 10);
+        long z = strtol(col[1], NULL, 10);
+        bool near = range_filter_update(&rf, z, (uint64_t)t_ms * 1000);
+        int32_t mm = range_filter_mm(&rf);
+
+        long esperado, lo, hi;
+        if (campo(col[2], &esperado) && near != esperado) {
+            fprintf(stderr, "%s:%d t=%ld z=%ld: near %d, esperado %ld (mm %d)\n", path, n,
+                    t_ms, z, near, esperado, mm);
+            check_failures++;
+        }
+        if (campo(col[3], &lo) && campo(col[4], &hi) && (mm < lo || mm > hi)) {
+            fprintf(stderr, "%s:%d t=%ld z=%ld: %d mm fora de [%ld, %ld]\n", path, n, t_ms, z,
+                    mm, lo, hi);
+            check_failures++;
+        }
+    }
+    fclose(f);
+    CHECK(n > 0);
+    printf("%s: %d leituras, %d falha(s), %u fora do gate\n", path, n,
+           check_failures - erros, rf.outliers);
+}
+
+int main(int argc, char **argv) {
+    for (int i = 1; i < argc; i++) replay(argv[i]);
+    return check_result("range_filter");
+}
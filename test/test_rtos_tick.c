@@ -0,0 +1,124 @@
+// Contas do tick tickless contra um relógio simulado: períodos acordados
+// com latência de IRQ, sonos longos que acabam no alarme (atrasado ou
+// não) ou antes dele por outra IRQ. Depois de cada evento a contagem de
+// ticks tem de ser exatamente o número de bordas até agora, sem deriva
+// em horas de simulação.
+
+#include <stdlib.h>
+
+#include "check.h"
+#include "rtos_tick_math.h"
+
+#define TICK_US 10000u
+#define EVENTOS 1000000
+
+static uint32_t semente = 1;
+
+static uint32_t sorteio(uint32_t n) {
+    semente = semente * 1103515245u + 12345u;
+    return (semente >> 8) % n;
+}
+
+// Estado do "port": próxima borda, alarme e ticks entregues ao kernel
+static uint64_t agora;
+static uint64_t next_tick_us;
+static uint64_t alarme;
+static uint64_t ticks;
+
+static void tick_irq(void) {
+    ticks += rtos_tick_due(&next_tick_us, agora, TICK_US);
+    alarme = next_tick_us;
+}
+
+// Acordado até t: cada alarme roda tick_irq com até 50 µs de latência
+static void acordado(uint64_t t) {
+    while (alarme <= t) {
+        agora = alarme + sorteio(50);
+        tick_irq();
+    }
+    agora = t;
+}
+
+// Sono de esperado ticks; outra IRQ em outra_us pode acordar antes.
+// Devolve os passos dados a vTaskStepTick.
+static uint32_t dorme(uint32_t esperado, uint64_t outra_us) {
+    uint64_t wake = rtos_tick_wake_us(next_tick_us, esperado, TICK_US);
+    alarme = wake;
+    uint64_t acorda = wake < outra_us ? wake : outra_us;
+    if (acorda < agora) acorda = agora;
+    agora = acorda + sorteio(300);
+
+    uint32_t passos = rtos_tick_catch_up(&next_tick_us, agora, wake, esperado, TICK_US);
+    // vTaskStepTick não pode chegar à hora de desbloquear a tarefa
+    CHECK(passos < esperado);
+    ticks += passos;
+    if (agora < wake) alarme = next_tick_us;
+    // O alarme pendente roda assim que as IRQs voltam
+    if (alarme <= agora) tick_irq();
+    return passos;
+}
+
+static void checa_bordas(void) {
+    CHECK_EQ(ticks, agora / TICK_US);
+    CHECK(next_tick_us > agora);
+    CHECK_EQ(next_tick_us % TICK_US, 0);
+}
+
+static void test_casos(void) {
+    agora = 0;
+    next_tick_us = TICK_US;
+    alarme = next_tick_us;
+    ticks = 0;
+
+    // Alarme no horário: deixa a última borda para a IRQ
+    acordado(5000);
+    CHECK_EQ(dorme(10, UINT64_MAX) + 1, 10);
+    checa_bordas();
+
+    // Acordado por outra IRQ entre duas bordas
+    uint64_t t0 = ticks;
+    uint32_t p = dorme(100, agora + 35 * TICK_US + 1234);
+    CHECK(p >= 35 && p < 37);
+    CHECK(ticks >= t0 + 35);
+    checa_bordas();
+
+    // Outra IRQ antes da primeira borda: nenhum passo
+    acordado(next_tick_us - 2000);
+    CHECK_EQ(dorme(50, agora), 0);
+    checa_bordas();
+
+    // Borda da IRQ adiantada não conta; atrasada conta todas
+    uint64_t n = next_tick_us;
+    CHECK_EQ(rtos_tick_due(&n, n - 1, TICK_US), 0);
+    CHECK_EQ(rtos_tick_due(&n, n + 3 * TICK_US, TICK_US), 4);
+}
+
+static void test_deriva(void) {
+    agora = 0;
+    next_tick_us = TICK_US;
+    alarme = next_tick_us;
+    ticks = 0;
+    semente = 1;
+    int falhas = 0;
+
+    for (long i = 0; i < EVENTOS && falhas < 5; i++) {
+        acordado(agora + sorteio(30000));
+        uint32_t esperado = 2 + sorteio(5000);
+        uint64_t outra = sorteio(3) == 0 ? agora + sorteio(esperado * TICK_US) : UINT64_MAX;
+        dorme(esperado, outra);
+        if (ticks != agora / TICK_US || next_tick_us <= agora) {
+            fprintf(stderr, "evento %ld: %llu ticks, esperado %llu\n", i,
+                    (unsigned long long)ticks, (unsigned long long)(agora / TICK_US));
+            falhas++;
+        }
+    }
+    CHECK_EQ(falhas, 0);
+    // Mais de um dia simulado
+    CHECK(agora > 24ull * 3600 * 1000000);
+}
+
+int main(void) {
+    test_casos();
+    test_deriva();
+    return check_result("rtos_tick");
+}
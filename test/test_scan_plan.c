@@ -0,0 +1,175 @@
+// Varredura foveada contra objetos com trajetória roteirizada: servo a
+// 60°/s, um ping a cada 40 ms com feixe de ±5°. Compara quantas vezes o
+// feixe volta ao objeto na varredura uniforme e na foveada, e confere
+// que sem objeto, objeto longe ou região larga demais a varredura fica
+// completa.
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "check.h"
+#include "scan_plan.h"
+
+#define VEL_MDEG_MS 60     // 60°/s
+#define PING_MS 40
+#define FEIXE_MDEG 5000
+#define ROI_MM 800
+#define HOLD_MS 4000
+#define PASSADAS 8
+#define SIM_MS 120000
+
+// Ângulo do objeto em mdeg no instante t (< 0 = sem objeto) e distância
+typedef int32_t (*trajetoria_t)(uint32_t t_ms);
+
+typedef struct {
+    trajetoria_t obj[2];
+    int32_t mm;
+    uint32_t some_ms;   // o objeto some a partir daqui (0 = nunca)
+} cena_t;
+
+typedef struct {
+    uint32_t visitas;       // passagens do feixe pelo objeto
+    uint32_t hits;          // pings com eco do objeto
+    uint32_t maior_vazio;   // maior tempo sem eco do objeto, em ms
+    uint32_t full_sweeps;
+    uint32_t roi_passes;
+    uint32_t roi_passes_depois;  // passadas na região depois que o objeto sumiu
+    bool alvo_fora;              // algum alvo fora de 0..180°
+} resultado_t;
+
+static int32_t parado_60(uint32_t t) {
+    return 60000;
+}
+
+// 60° ± 20°, período de 8 s
+static int32_t oscila_60(uint32_t t) {
+    return 60000 + (int32_t)lround(20000 * sin(2 * M_PI * t / 8000.0));
+}
+
+// Atravessa de 20° a 160° em 2 minutos
+static int32_t atravessa(uint32_t t) {
+    return 20000 + (int32_t)((uint64_t)t * 140000 / SIM_MS);
+}
+
+static int32_t parado_30(uint32_t t) {
+    return 30000;
+}
+
+static int32_t parado_150(uint32_t t) {
+    return 150000;
+}
+
+static void simula(const cena_t *c, uint8_t passadas, resultado_t *r) {
+    scan_plan_t p;
+    scan_plan_init(&p, ROI_MM, HOLD_MS, passadas);
+    *r = (resultado_t){0};
+
+    int32_t pos = 0;
+    int32_t alvo = scan_plan_next(&p, pos, 0);
+    bool no_feixe = false;
+    uint32_t ultimo_hit = 0;
+    uint32_t roi_no_sumico = 0;
+
+    for (uint32_t t = 1; t <= SIM_MS; t++) {
+        if (pos < alvo) pos = pos + VEL_MDEG_MS > alvo ? alvo : pos + VEL_MDEG_MS;
+        else if (pos > alvo) pos = pos - VEL_MDEG_MS < alvo ? alvo : pos - VEL_MDEG_MS;
+
+        bool presente = !c->some_ms || t < c->some_ms;
+        if (c->some_ms && t == c->some_ms) roi_no_sumico = p.roi_passes;
+
+        if (t % PING_MS == 0) {
+            bool hit = false;
+            for (int i = 0; i < 2; i++) {
+                if (!presente || !c->obj[i]) continue;
+                int32_t d = pos - c->obj[i](t);
+                if (d >= -FEIXE_MDEG && d <= FEIXE_MDEG) hit = true;
+            }
+            scan_plan_observe(&p, pos, hit ? c->mm : -1, t);
+            if (hit) {
+                if (!no_feixe) r->visitas++;
+                // Depois da primeira passada: a partida não conta
+                if (ultimo_hit && t - ultimo_hit > r->maior_vazio) r->maior_vazio = t - ultimo_hit;
+                ultimo_hit = t;
+                r->hits++;
+            }
+            no_feixe = hit;
+        }
+
+        if (pos == alvo) {
+            alvo = scan_plan_next(&p, pos, t);
+            if (alvo < 0 || alvo > 180000) r->alvo_fora = true;
+        }
+    }
+    r->full_sweeps = p.full_sweeps;
+    r->roi_passes = p.roi_passes;
+    if (c->some_ms) r->roi_passes_depois = p.roi_passes - roi_no_sumico;
+}
+
+// Mesmo objeto, uniforme contra foveada: a foveada volta ao objeto bem
+// mais vezes. Um objeto que sai da margem da região enquanto as passadas
+// densas seguem nela só é achado de novo quando as marcas expiram e vem
+// a passada completa: o vazio máximo fica abaixo de hold_ms mais duas
+// passadas completas.
+static void compara(const char *nome, trajetoria_t obj) {
+    cena_t c = {{obj, NULL}, 400, 0};
+    resultado_t uni, fov;
+    simula(&c, 0, &uni);
+    simula(&c, PASSADAS, &fov);
+    printf("%s: uniforme %u visitas (vazio máx %u ms), foveada %u visitas (%u ms)\n", nome,
+           uni.visitas, uni.maior_vazio, fov.visitas, fov.maior_vazio);
+
+    CHECK_EQ(uni.roi_passes, 0);
+    CHECK(fov.roi_passes > 0);
+    CHECK(fov.full_sweeps > 0);
+    CHECK(2 * fov.visitas >= 3 * uni.visitas);
+    CHECK(fov.maior_vazio < HOLD_MS + 2 * 180000 / VEL_MDEG_MS);
+    CHECK(!uni.alvo_fora && !fov.alvo_fora);
+}
+
+static void test_trajetorias(void) {
+    compara("parado", parado_60);
+    compara("oscilando", oscila_60);
+    compara("atravessando", atravessa);
+}
+
+// Sem eco perto, ou eco além de roi_mm: só varreduras completas
+static void test_sem_regiao(void) {
+    resultado_t r;
+    cena_t vazio = {{NULL, NULL}, 400, 0};
+    simula(&vazio, PASSADAS, &r);
+    CHECK_EQ(r.roi_passes, 0);
+    // 120 s a 3 s por passada
+    CHECK(r.full_sweeps >= 38);
+
+    cena_t longe = {{parado_60, NULL}, ROI_MM + 100, 0};
+    simula(&longe, PASSADAS, &r);
+    CHECK_EQ(r.roi_passes, 0);
+    CHECK(r.hits > 0);
+}
+
+// Dois objetos a 120° um do outro: região larga demais, volta ao uniforme
+static void test_regiao_larga(void) {
+    resultado_t r;
+    cena_t dois = {{parado_30, parado_150}, 400, 0};
+    simula(&dois, PASSADAS, &r);
+    CHECK_EQ(r.roi_passes, 0);
+}
+
+// O objeto some: a região expira depois de hold_ms e as passadas densas
+// param
+static void test_objeto_some(void) {
+    resultado_t r;
+    cena_t c = {{parado_60, NULL}, 400, SIM_MS / 2};
+    simula(&c, PASSADAS, &r);
+    CHECK(r.roi_passes > 0);
+    // No máximo a rodada de passadas em curso mais uma dentro do hold
+    CHECK(r.roi_passes_depois <= 2 * PASSADAS);
+}
+
+int main(void) {
+    test_trajetorias();
+    test_sem_regiao();
+    test_regiao_larga();
+    test_objeto_some();
+    return check_result("scan_plan");
+}
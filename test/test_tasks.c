@@ -0,0 +1,576 @@
+// As tarefas de ranging, áudio, varredura e telemetria do firmware, no
+// kernel de verdade pelo port Posix do FreeRTOS, nas mesmas prioridades.
+// Só o hardware é de mentira: um roteiro faz o papel dos sonares e da
+// IRQ de fim de medição, do gravador (que roda o pipeline da tarefa de
+// áudio sobre blocos sintéticos), do servo e do stdio. O roteiro tem a
+// menor prioridade: cada notificação roda a cadeia inteira antes do
+// próximo passo, então o resultado não depende do relógio do host.
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "check.h"
+#include "ranging.h"
+#include "audio_task.h"
+#include "scan_task.h"
+#include "telem.h"
+
+#define PRIO_RANGING 4
+#define PRIO_AUDIO 3
+#define PRIO_SCAN 2
+#define PRIO_TELEM 1
+#define PRIO_ROTEIRO tskIDLE_PRIORITY
+#define PILHA 8192
+
+#define PASSO_MS 50
+#define LONGE_CM 150.0f
+#define PERTO_CM 5.0f
+// Sensor 1: parado mais perto que o sensor 0 longe, ainda além do watch_mm
+#define SENSOR1_CM 120.0f
+#define MAX_PASSOS 256
+
+// Gravador: um bloco de 32 ms por poll; pós-trigger de 10 blocos e
+// reprodução de 4
+#define BLOCO 256
+#define BLOCO_MS 32
+#define PRE_MS 1000
+#define POST_MS (10 * BLOCO_MS)
+#define TOCA_POLLS 4
+#define MAX_GRAVACOES 8
+
+// Servo: anda 20° por passo do roteiro
+#define SERVO_PASSO_MDEG 20000
+
+// Prazos longos: áudio e varredura só acordam pelo roteiro e pelos pings
+#define ESPERA_LONGA_MS 60000
+#define TELEM_ESPERA_MS 5
+#define TELEM_CARGA_MS 10
+
+// Fases do sensor 0; o sensor 1 fica parado em SENSOR1_CM
+typedef enum {
+    PARADO_LONGE,   // 2 s parado além do watch_mm, em silêncio
+    RUIDO,          // 0,5 s de tom, ainda longe
+    CHEGANDO,       // de 150 a 5 cm em 2 s
+    PARADO_PERTO,   // 1 s
+    SAIU,           // salta para longe por 1 s
+    VOLTOU,         // salta para perto por 1 s
+    N_FASES,
+} fase_t;
+
+static const uint32_t fase_passos[N_FASES] = {40, 10, 40, 20, 20, 20};
+
+typedef struct {
+    fase_t fase;
+    float cm;
+    bool som;
+} passo_t;
+
+static passo_t roteiro[MAX_PASSOS];
+static uint32_t n_passos;
+
+// Estado do driver de mentira, mexido só com a tarefa de ranging parada
+static volatile uint32_t passo;
+static volatile bool fresca[2];
+static volatile bool drenou;
+static uint32_t iniciou;
+static bool leu_antes_de_iniciar;
+static bool led;
+static bool led_no_passo[MAX_PASSOS];
+static uint32_t periodo = 0;
+static uint32_t periodo_fim_fase[N_FASES];
+static uint32_t periodos;
+
+// Ranging
+static uint32_t telem_bloqueio;
+static bool bloqueio_misturado;
+static uint32_t latencia_ms[2];
+static uint32_t passo_bloqueio[2];
+
+// Gravador
+static const dsp_pipeline_t *pipeline;
+static const audio_vad_t *gate;
+static audio_recorder_state_t rec = REC_IDLE;
+static uint32_t rec_resta;
+static uint32_t armou;
+static uint32_t pre_armado, post_armado;
+static bool fora_de_ordem;
+static uint32_t tocou;
+typedef struct {
+    uint32_t passo;
+    bool por_objeto;
+    bool pela_notificacao;  // antes do prazo de drenagem do passo
+} gravacao_t;
+static uint32_t gravacoes;
+static gravacao_t gravacao[MAX_GRAVACOES];
+static uint32_t avisos_tocando;
+
+// Servo
+static uint32_t assentou;
+static bool mexeu_antes_de_assentar;
+static int32_t servo_pos, servo_alvo;
+static int8_t servo_dir = 1;
+static uint32_t paradas;
+static bool mexeu_bloqueado;
+static bool parado_pelo_bloqueio;
+static int32_t alvo_ao_parar;
+static bool retomou_outro_alvo;
+static uint32_t retomadas;
+static uint32_t passadas;
+static bool passada_errada;
+static uint32_t pings;
+static bool ping_errado;
+
+// Telemetria
+static uint32_t telem_iniciou;
+static uint32_t voltas;
+static uint32_t linhas_distancia[2];
+static uint32_t linhas_bloqueio;
+static uint32_t linhas_objeto, linhas_som, linhas_vad, linhas_tocando, linhas_cpu;
+static bool linha_estranha;
+static char ultima_distancia1[128];
+static char ultima_cpu[128];
+
+static TaskHandle_t xRanging;
+static TaskHandle_t xAudio;
+static QueueHandle_t xFilaPings;
+static QueueHandle_t xFilaTelem;
+
+// audio_vad mede o próprio custo no relógio do mock
+uint64_t mock_time_us;
+
+static uint64_t hora_us(uint32_t p) {
+    return (uint64_t)(p + 1) * PASSO_MS * 1000;
+}
+
+// Disparo 2 ms antes da leitura; o servo anda 10 mdeg por ms
+static uint64_t disparo_us(uint32_t p) {
+    return hora_us(p) - 2000;
+}
+
+static int32_t mdeg_at(uint64_t us) {
+    return (int32_t)((us / 1000 * 10) % 180000);
+}
+
+// === Telemetria ===
+static void telem_inicio(void) {
+    telem_iniciou++;
+}
+
+static void saida(const char *linha) {
+    size_t n = strlen(linha);
+    if (n == 0 || linha[n - 1] != '\n') linha_estranha = true;
+    if (!strncmp(linha, "Distância 0:", 13)) {
+        linhas_distancia[0]++;
+    } else if (!strncmp(linha, "Distância 1:", 13)) {
+        linhas_distancia[1]++;
+        strncpy(ultima_distancia1, linha, sizeof(ultima_distancia1) - 1);
+    } else if (!strncmp(linha, "Sonar 0:", 8)) {
+        linhas_bloqueio++;
+    } else if (!strcmp(linha, "Objeto detectado! Gravando...\n")) {
+        linhas_objeto++;
+    } else if (!strcmp(linha, "Som detectado! Gravando...\n")) {
+        linhas_som++;
+    } else if (!strncmp(linha, "VAD: ", 5)) {
+        linhas_vad++;
+    } else if (!strcmp(linha, "Reproduzindo...\n")) {
+        linhas_tocando++;
+    } else if (!strncmp(linha, "CPU: ", 5)) {
+        linhas_cpu++;
+        strncpy(ultima_cpu, linha, sizeof(ultima_cpu) - 1);
+    } else {
+        linha_estranha = true;
+    }
+}
+
+static void carga(telem_carga_t *c) {
+    c->ociosa_permille = 875;
+    c->sonos = 3;
+    c->ticks_pulados = 7;
+}
+
+static void volta(void) {
+    voltas++;
+}
+
+static const telem_io_t telem_io = {
+    .iniciar = telem_inicio,
+    .saida = saida,
+    .carga = carga,
+    .volta = volta,
+};
+
+static telem_t telem = {
+    .io = &telem_io,
+    .espera_ms = TELEM_ESPERA_MS,
+    .carga_ms = TELEM_CARGA_MS,
+};
+
+// === Ranging ===
+static void iniciar(void) {
+    iniciou++;
+}
+
+static bool ler(uint32_t i, float *cm, uint64_t *trigger_us) {
+    if (!iniciou) leu_antes_de_iniciar = true;
+    if (i > 1 || !fresca[i]) return false;
+    fresca[i] = false;
+    *cm = i == 0 ? roteiro[passo].cm : SENSOR1_CM;
+    *trigger_us = disparo_us(passo);
+    return true;
+}
+
+static void set_period_ms(uint32_t ms) {
+    periodo = ms;
+    periodos++;
+}
+
+static void set_led(bool on) {
+    led = on;
+}
+
+static uint64_t agora_us(void) {
+    return hora_us(passo);
+}
+
+// O escalonador que chega é o do sensor que bloqueou: as detecções dele
+// contam uma a uma, mesmo com o sensor 1 mais perto nas fases longe
+static void aviso_bloqueio(uint32_t i, const ping_sched_t *s) {
+    if (telem_bloqueio < 2) {
+        latencia_ms[telem_bloqueio] = s->latency_ms_last;
+        passo_bloqueio[telem_bloqueio] = passo;
+    }
+    telem_bloqueio++;
+    if (i != 0 || s->detections != telem_bloqueio) bloqueio_misturado = true;
+    telem_send(&telem, TELEM_BLOQUEIO, i, s->pings_per_s, s->latency_ms_last,
+               ping_sched_mean_latency_ms(s), s->latency_ms_max);
+}
+
+static void aviso_distancia(uint32_t i, int32_t mm, int32_t mdeg, const range_filter_t *f) {
+    telem_send(&telem, TELEM_DISTANCIA, i, mm, mdeg, range_filter_mm(f),
+               range_filter_closing_mm_s(f));
+}
+
+static const ranging_io_t ranging_io = {
+    .iniciar = iniciar,
+    .ler = ler,
+    .set_period_ms = set_period_ms,
+    .led = set_led,
+    .mdeg_at = mdeg_at,
+    .agora_us = agora_us,
+    .bloqueio = aviso_bloqueio,
+    .distancia = aviso_distancia,
+};
+
+static ranging_t ranging = {
+    .io = &ranging_io,
+    .n_sonares = 2,
+    .entra_mm = 100,
+    .sai_mm = 120,
+    .min_ms = 25,
+    .max_ms = 250,
+    .watch_mm = 1000,
+    .audio = &xAudio,
+};
+
+// === Gravador ===
+// Tom de 1 kHz a 8 kHz ou quase silêncio
+static void gera_bloco(int16_t *b, bool som) {
+    static const int16_t tom[8] = {0, 5657, 8000, 5657, 0, -5657, -8000, -5657};
+    static uint32_t semente = 1;
+    for (int i = 0; i < BLOCO; i++) {
+        semente = semente * 1103515245u + 12345u;
+        b[i] = som ? tom[i % 8] : (int16_t)((semente >> 16) % 17) - 8;
+    }
+}
+
+static void rec_set_pipeline(const dsp_pipeline_t *p) {
+    pipeline = p;
+}
+
+static void rec_set_gate(const audio_vad_t *vad) {
+    gate = vad;
+}
+
+static void rec_arm(uint32_t pre_ms, uint32_t post_ms) {
+    if (rec != REC_IDLE) fora_de_ordem = true;
+    rec = REC_ARMED;
+    pre_armado = pre_ms;
+    post_armado = post_ms;
+    armou++;
+}
+
+static void rec_trigger(void) {
+    if (rec != REC_ARMED) fora_de_ordem = true;
+    rec = REC_TRIGGERED;
+    rec_resta = post_armado / BLOCO_MS;
+}
+
+static audio_recorder_state_t rec_state(void) {
+    return rec;
+}
+
+// Um bloco de captura por poll, pelo pipeline da tarefa: o VAD decide
+// com o som do passo
+static audio_recorder_state_t rec_poll(void) {
+    int16_t bloco[BLOCO];
+    gera_bloco(bloco, roteiro[passo].som);
+    if (pipeline) dsp_pipeline_run(pipeline, bloco, BLOCO);
+    if ((rec == REC_TRIGGERED || rec == REC_PLAYING) && --rec_resta == 0)
+        rec = rec == REC_TRIGGERED ? REC_FROZEN : REC_IDLE;
+    return rec;
+}
+
+static void rec_play(void) {
+    if (rec != REC_FROZEN) fora_de_ordem = true;
+    rec = REC_PLAYING;
+    rec_resta = TOCA_POLLS;
+    tocou++;
+}
+
+static void aviso_gravando(bool por_objeto, const audio_vad_t *vad) {
+    if (gravacoes < MAX_GRAVACOES)
+        gravacao[gravacoes] = (gravacao_t){passo, por_objeto, !drenou};
+    gravacoes++;
+    telem_send(&telem, TELEM_GRAVANDO, por_objeto, audio_vad_mean_cost_us(vad), vad->cost_us_max,
+               0, 0);
+}
+
+static void aviso_tocando(void) {
+    avisos_tocando++;
+    telem_send(&telem, TELEM_TOCANDO, 0, 0, 0, 0, 0);
+}
+
+static const audio_io_t audio_io = {
+    .set_pipeline = rec_set_pipeline,
+    .set_gate = rec_set_gate,
+    .arm = rec_arm,
+    .trigger = rec_trigger,
+    .state = rec_state,
+    .poll = rec_poll,
+    .play = rec_play,
+    .gravando = aviso_gravando,
+    .tocando = aviso_tocando,
+};
+
+static audio_task_t gravador = {
+    .io = &audio_io,
+    .modo = AUDIO_TRIGGER_QUALQUER,
+    .gate = true,
+    .pre_ms = PRE_MS,
+    .post_ms = POST_MS,
+    .espera_ms = ESPERA_LONGA_MS,
+    .ranging = &ranging,
+};
+
+// === Servo ===
+static void assentar(void) {
+    assentou++;
+}
+
+static int32_t servo_mdeg(void) {
+    return servo_pos;
+}
+
+static bool servo_chegou(void) {
+    return servo_pos == servo_alvo;
+}
+
+static void servo_mover(int32_t mdeg) {
+    if (!assentou) mexeu_antes_de_assentar = true;
+    if (ranging.bloqueado) mexeu_bloqueado = true;
+    if (parado_pelo_bloqueio) {
+        if (mdeg != alvo_ao_parar) retomou_outro_alvo = true;
+        parado_pelo_bloqueio = false;
+        retomadas++;
+    }
+    if (mdeg != servo_pos) servo_dir = mdeg > servo_pos ? 1 : -1;
+    servo_alvo = mdeg;
+}
+
+static void servo_parar(void) {
+    alvo_ao_parar = servo_alvo;
+    parado_pelo_bloqueio = true;
+    servo_alvo = servo_pos;
+    paradas++;
+}
+
+// O timer de hardware: o servo anda entre dois passos do roteiro
+static void servo_anda(void) {
+    int32_t d = servo_alvo - servo_pos;
+    if (d > SERVO_PASSO_MDEG) d = SERVO_PASSO_MDEG;
+    if (d < -SERVO_PASSO_MDEG) d = -SERVO_PASSO_MDEG;
+    servo_pos += d;
+}
+
+static uint32_t agora_ms(void) {
+    return hora_us(passo) / 1000;
+}
+
+static void ping(const ping_t *p) {
+    int32_t mm = (int32_t)(roteiro[passo].cm * 10.0f);
+    if (p->mm != mm || p->mdeg != mdeg_at(disparo_us(passo)) || p->ms != hora_us(passo) / 1000)
+        ping_errado = true;
+    pings++;
+}
+
+static void fim_passada(int8_t dir) {
+    if (dir != servo_dir) passada_errada = true;
+    passadas++;
+}
+
+static const scan_io_t scan_io = {
+    .assentar = assentar,
+    .mdeg = servo_mdeg,
+    .chegou = servo_chegou,
+    .mover = servo_mover,
+    .parar = servo_parar,
+    .agora_ms = agora_ms,
+    .ping = ping,
+    .fim_passada = fim_passada,
+};
+
+static scan_task_t varredura = {
+    .io = &scan_io,
+    .ranging = &ranging,
+    .watch_mm = 1000,
+    .marca_ms = 4000,
+    .passadas = 8,
+    .quadro_ms = ESPERA_LONGA_MS,
+};
+
+static void monta_roteiro(void) {
+    n_passos = 0;
+    for (fase_t f = 0; f < N_FASES; f++) {
+        for (uint32_t k = 0; k < fase_passos[f]; k++) {
+            float cm = LONGE_CM;
+            if (f == CHEGANDO)
+                cm = LONGE_CM - (LONGE_CM - PERTO_CM) * (k + 1) / fase_passos[f];
+            else if (f == PARADO_PERTO || f == VOLTOU)
+                cm = PERTO_CM;
+            roteiro[n_passos++] = (passo_t){f, cm, f == RUIDO};
+        }
+    }
+}
+
+static void confere(void) {
+    uint32_t ini[N_FASES + 1] = {0};
+    for (fase_t f = 0; f < N_FASES; f++) ini[f + 1] = ini[f] + fase_passos[f];
+
+    // === Ranging ===
+    CHECK_EQ(iniciou, 1);
+    CHECK(!leu_antes_de_iniciar);
+    // Bloqueia chegando, solta quando sai, bloqueia de novo quando volta
+    CHECK_EQ(telem_bloqueio, 2);
+    CHECK(!bloqueio_misturado);
+    // Da última leitura livre do sensor 0 até o bloqueio: poucos pings
+    CHECK(latencia_ms[0] > 0 && latencia_ms[0] <= 10 * PASSO_MS);
+    CHECK(latencia_ms[1] > 0 && latencia_ms[1] <= 10 * PASSO_MS);
+    CHECK(led);
+    CHECK(!led_no_passo[ini[CHEGANDO] - 1]);
+    CHECK(led_no_passo[ini[PARADO_PERTO + 1] - 1]);
+    CHECK(!led_no_passo[ini[SAIU + 1] - 1]);
+    CHECK(led_no_passo[ini[VOLTOU + 1] - 1]);
+    for (uint32_t k = 0; k < n_passos; k++)
+        if (led_no_passo[k] && roteiro[k].fase < CHEGANDO) CHECK(false);
+    // Ritmo: lento com a cena parada longe, mínimo com o objeto perto
+    CHECK(periodos > 0);
+    CHECK_EQ(periodo_fim_fase[PARADO_LONGE], ranging.max_ms);
+    CHECK_EQ(periodo_fim_fase[PARADO_PERTO], ranging.min_ms);
+
+    // === Áudio ===
+    // Pipeline e gate da tarefa, janela da configuração
+    CHECK(pipeline != NULL);
+    CHECK(gate != NULL);
+    CHECK_EQ(pre_armado, PRE_MS);
+    CHECK_EQ(post_armado, POST_MS);
+    CHECK(!fora_de_ordem);
+    // Três subidas, cada uma grava uma vez: o tom, o objeto chegando e o
+    // objeto voltando. Parado perto não grava de novo.
+    CHECK_EQ(gravacoes, 3);
+    CHECK(!gravacao[0].por_objeto);
+    CHECK(gravacao[0].passo >= ini[RUIDO] && gravacao[0].passo < ini[RUIDO] + 2);
+    // As do objeto saem no passo em que o ranging bloqueia: quem acorda o
+    // áudio é a notificação da tarefa de ranging, antes do prazo de
+    // drenagem do passo
+    CHECK(passo_bloqueio[0] >= ini[CHEGANDO] && passo_bloqueio[0] < ini[SAIU]);
+    CHECK(passo_bloqueio[1] >= ini[VOLTOU]);
+    for (int g = 1; g <= 2; g++) {
+        CHECK(gravacao[g].por_objeto);
+        CHECK_EQ(gravacao[g].passo, passo_bloqueio[g - 1]);
+        CHECK(gravacao[g].pela_notificacao);
+    }
+    // Cada clipe congelado toca e o gravador rearma no fim
+    CHECK_EQ(tocou, 3);
+    CHECK_EQ(avisos_tocando, tocou);
+    CHECK_EQ(armou, 1 + tocou - (rec == REC_PLAYING));
+
+    // === Varredura ===
+    CHECK_EQ(assentou, 1);
+    CHECK(!mexeu_antes_de_assentar);
+    // Um ping por leitura do sensor 0, na ordem, nenhum perdido
+    CHECK_EQ(pings, n_passos);
+    CHECK(!ping_errado);
+    // Para uma vez por bloqueio, não se mexe bloqueado e retoma o alvo
+    CHECK_EQ(paradas, 2);
+    CHECK(!mexeu_bloqueado);
+    CHECK_EQ(retomadas, 1);
+    CHECK(!retomou_outro_alvo);
+    CHECK(passadas > 2);
+    CHECK(!passada_errada);
+
+    // === Telemetria ===
+    CHECK_EQ(telem_iniciou, 1);
+    CHECK(voltas > 0);
+    CHECK(!linha_estranha);
+    CHECK_EQ(linhas_distancia[0], n_passos);
+    CHECK_EQ(linhas_distancia[1], n_passos);
+    CHECK(!strncmp(ultima_distancia1, "Distância 1: 1200 mm a ", 24));
+    CHECK_EQ(linhas_bloqueio, 2);
+    CHECK_EQ(linhas_som, 1);
+    CHECK_EQ(linhas_objeto, 2);
+    CHECK_EQ(linhas_vad, 3);
+    CHECK_EQ(linhas_tocando, 3);
+    CHECK(linhas_cpu > 0);
+    CHECK(!strcmp(ultima_cpu, "CPU: 87.5% ociosa, 3 sonos, 7 ticks pulados\n"));
+}
+
+// Faz o papel das IRQs e do relógio: publica a leitura e acorda a tarefa
+// de ranging, depois o áudio pelo prazo de drenagem, depois anda o servo.
+// Todas as outras tarefas têm prioridade maior, então quando cada notify
+// volta a cadeia inteira já rodou.
+static void roteiro_task(void *p) {
+    for (passo = 0; passo < n_passos; passo++) {
+        mock_time_us = hora_us(passo);
+        fresca[0] = fresca[1] = true;
+        drenou = false;
+        xTaskNotifyGive(xRanging);
+        drenou = true;
+        xTaskNotifyGive(xAudio);
+        servo_anda();
+        led_no_passo[passo] = led;
+        CHECK(ranging.bloqueado == led);
+        periodo_fim_fase[roteiro[passo].fase] = periodo ? periodo : ranging.max_ms;
+    }
+    passo = n_passos - 1;
+    // A telemetria acorda sozinha pelo prazo da fila: espera o relatório
+    // de carga, que depende do relógio
+    vTaskDelay(pdMS_TO_TICKS(5 * TELEM_CARGA_MS));
+    confere();
+    exit(check_result("tasks"));
+}
+
+int main(void) {
+    monta_roteiro();
+    xFilaPings = xQueueCreate(8, sizeof(ping_t));
+    xFilaTelem = xQueueCreate(16, sizeof(telem_msg_t));
+    ranging.pings = xFilaPings;
+    varredura.pings = xFilaPings;
+    telem.fila = xFilaTelem;
+    xTaskCreate(ranging_task, "Ranging", PILHA, &ranging, PRIO_RANGING, &xRanging);
+    xTaskCreate(audio_task, "Audio", PILHA, &gravador, PRIO_AUDIO, &xAudio);
+    xTaskCreate(scan_task, "Scan", PILHA, &varredura, PRIO_SCAN, NULL);
+    xTaskCreate(telem_task, "Telem", PILHA, &telem, PRIO_TELEM, NULL);
+    xTaskCreate(roteiro_task, "Roteiro", PILHA, NULL, PRIO_ROTEIRO, NULL);
+    vTaskStartScheduler();
+    return 1;
+}
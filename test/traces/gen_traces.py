@@ -0,0 +1,125 @@
+#!/usr/bin/env python3
+
+# Gera os traços sintéticos de replay do filtro de distância deste
+# diretório: verdade de chão conhecida mais ruído, sem captura do sensor.
+# Cada linha: t_ms, z_mm (-1 = sem eco), depois o esperado conferido por
+# test_range_filter: near (0/1) e a janela do mm filtrado [lo, hi];
+# '-' = tanto faz (transições que o filtro pode levar alguns pings para
+# acompanhar).
+
+# Uso: python3 gen_traces.py
+
+import random
+
+random.seed(13)
+
+NOISE_MM = 3
+
+
+def ping_period():
+    return random.randint(25, 60)
+
+
+def write(name, rows, header):
+    with open(name, 'w') as f:
+        f.write('# ' + header + '\n')
+        f.write('# t_ms,z_mm,near,mm_lo,mm_hi\n')
+        for r in rows:
+            f.write(','.join(str(x) for x in r) + '\n')
+
+
+def z(truth):
+    return truth + random.randint(-NOISE_MM, NOISE_MM)
+
+
+def spikes():
+    # Alvo parado a 300 mm; picos de um ping, longe e perto, de tempos em
+    # tempos não podem mexer nem na estimativa nem na decisão de perto
+    rows, t = [], 0
+    for i in range(400):
+        t += ping_period()
+        zz = z(300)
+        if i > 10 and i % 37 == 0:
+            zz = 2500
+        if i > 10 and i % 53 == 0:
+            zz = 40
+        settled = i >= 5
+        rows.append((t, zz, 0, 290 if settled else '-', 310 if settled else '-'))
+    return rows
+
+
+def dropouts():
+    # Mão a 80 mm: rajadas de até 4 ecos perdidos mantêm a trilha e o
+    # bloqueio; 5 seguidos largam o alvo, um eco novo o readquire
+    rows, t = [], 0
+    for i in range(120):
+        t += ping_period()
+        missing = i % 20 in range(12, 12 + 1 + i // 30) and i < 110
+        if missing:
+            rows.append((t, -1, 1, 60, 100))
+        else:
+            rows.append((t, z(80), 1 if i >= 2 else '-', 70 if i >= 2 else '-', 90 if i >= 2 else '-'))
+    for k in range(5):
+        t += ping_period()
+        lost = k == 4
+        rows.append((t, -1, 0 if lost else 1, -1 if lost else 60, -1 if lost else 100))
+    for k in range(10):
+        t += ping_period()
+        rows.append((t, z(80), 1, 70, 90))
+    return rows
+
+
+def reseed():
+    # 500 mm, depois outro objeto a 200 mm (salto fora do gate): a
+    # mediana e três rejeições do gate semeiam de novo na distância nova;
+    # depois um buraco de 1 s nos pings reinicia a trilha na leitura nova
+    rows, t = [], 0
+    for i in range(60):
+        t += ping_period()
+        rows.append((t, z(500), 0, 490 if i >= 2 else '-', 510 if i >= 2 else '-'))
+    for i in range(60):
+        t += ping_period()
+        ok = i >= 8
+        rows.append((t, z(200), 0, 190 if ok else '-', 210 if ok else '-'))
+    t += 1000
+    rows.append((t, z(700), 0, 690, 710))
+    for i in range(20):
+        t += ping_period()
+        rows.append((t, z(700), 0, 690, 710))
+    return rows
+
+
+def hysteresis():
+    # Aproximação lenta de 200 a 80 mm e volta a 40 mm/s: perto liga
+    # abaixo de 100 mm e segura até o alvo passar de 120 mm
+    rows, t = [], 0
+    truth = 200.0
+    path = [(-40, 80), (0, 80), (40, 200)]
+    for speed, stop in path:
+        hold = 0
+        while True:
+            dt = ping_period()
+            t += dt
+            truth += speed * dt / 1000
+            if speed < 0:
+                truth = max(truth, stop)
+                near = 0 if truth > 106 else 1 if truth < 94 else '-'
+            elif speed > 0:
+                truth = min(truth, stop)
+                near = 1 if truth < 114 else 0 if truth > 126 else '-'
+            else:
+                near = 1
+            rows.append((t, z(round(truth)), near, round(truth) - 12, round(truth) + 12))
+            if speed == 0:
+                hold += 1
+                if hold >= 20:
+                    break
+            elif truth == stop:
+                break
+    return rows
+
+
+write('spikes.csv', spikes(), 'parado a 300 mm com picos de um ping')
+write('dropouts.csv', dropouts(), 'alvo perto com rajadas sem eco, depois perdido e readquirido')
+write('reseed.csv', reseed(), 'salto para outro objeto, depois um buraco nos pings')
+write('hysteresis.csv', hysteresis(), 'aproxima e afasta cruzando os limiares de 100/120 mm')